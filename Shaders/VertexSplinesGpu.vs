@@ -0,0 +1,33 @@
+#version 400 core
+
+//Segment k is texels 2k (x a, b, c, d) and 2k + 1 (y a, b, c, d)
+uniform samplerBuffer coefficients;
+//First vertex of segment k, then the vertex closing the path at texel segments
+uniform isamplerBuffer starts;
+uniform int segments;
+
+uniform mat4 model;
+
+void main()
+{
+    //Last segment starting at or before this vertex, the closing vertex lands on t = 1 of the last segment
+    int low = 0;
+    int high = segments - 1;
+    while (low < high) {
+        int middle = (low + high + 1) / 2;
+        if (texelFetch(starts, middle).x <= gl_VertexID) {
+            low = middle;
+        }
+        else {
+            high = middle - 1;
+        }
+    }
+    int segment = low;
+    int first = texelFetch(starts, segment).x;
+    float t = float(gl_VertexID - first) / float(texelFetch(starts, segment + 1).x - first);
+
+    vec4 x = texelFetch(coefficients, 2 * segment);
+    vec4 y = texelFetch(coefficients, 2 * segment + 1);
+    vec2 position = vec2(x.x + t * (x.y + t * (x.z + t * x.w)), y.x + t * (y.y + t * (y.z + t * y.w)));
+    gl_Position = model * vec4(position, 0, 1);
+}
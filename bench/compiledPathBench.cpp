@@ -0,0 +1,114 @@
+//Latency of single CompiledPath evaluations, the way a control loop calls them
+//Every call is timed on its own with steady_clock and the median cost of reading the clock is subtracted
+//Usage: compiledPathBench [waypoints] [calls]
+#include "compiledPath.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+typedef std::chrono::steady_clock Clock;
+
+//Every result is stored here so the calls can't be optimized away
+static volatile float sink;
+
+//Median time of two back to back clock reads
+static double timerOverhead() {
+    std::vector<double> samples(100000);
+    for(double &sample : samples) {
+        auto start = Clock::now();
+        auto end = Clock::now();
+        sample = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+//Times evaluate on every query and prints p50, p99 and p99.9 in nanoseconds
+template <typename Evaluate>
+static void report(const char *name, const std::vector<float> &queries, double overhead, Evaluate evaluate) {
+    std::vector<double> latency(queries.size());
+    for(size_t i = 0; i < queries.size(); i++) {
+        auto start = Clock::now();
+        PathState state = evaluate(queries[i]);
+        auto end = Clock::now();
+        sink = state.heading;
+        latency[i] = std::max(std::chrono::duration<double, std::nano>(end - start).count() - overhead, 0.0);
+    }
+    std::sort(latency.begin(), latency.end());
+    auto percentile = [&](double p) { return latency[std::min((size_t)(p * latency.size()), latency.size() - 1)]; };
+    std::printf("%-36s %10.1f %10.1f %10.1f\n", name, percentile(0.5), percentile(0.99), percentile(0.999));
+}
+
+//Uniformly random queries between start and end
+static std::vector<float> randomQueries(std::mt19937 &rng, int count, float start, float end) {
+    std::uniform_real_distribution<float> value(start, end);
+    std::vector<float> queries(count);
+    for(float &query : queries) {
+        query = value(rng);
+    }
+    return queries;
+}
+
+static void benchPath(const char *name, const CompiledPath &path, std::mt19937 &rng, int calls, double overhead) {
+    std::printf("%s: %d segments, length %.1f, %.1f s\n", name, path.segmentCount(), path.length(), path.duration());
+    std::vector<float> parameters = randomQueries(rng, calls, path.parameterStart(), path.parameterEnd());
+    std::vector<float> distances = randomQueries(rng, calls, 0, path.length());
+    std::vector<float> times = randomQueries(rng, calls, 0, path.duration());
+    report("  evaluate", parameters, overhead, [&](float t) { return path.evaluate(t); });
+    report("  evaluateAtDistance", distances, overhead, [&](float d) { return path.evaluateAtDistance(d); });
+    report("  evaluateAtTime", times, overhead, [&](float s) { return path.evaluateAtTime(s); });
+}
+
+int main(int argc, char **argv) {
+    int waypoints = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int calls = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    if(waypoints < 3 || calls < 1) {
+        std::printf("usage: compiledPathBench [waypoints >= 3] [calls >= 1]\n");
+        return 1;
+    }
+
+    //A random walk of waypoints about half a unit apart
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    std::vector<glm::vec2> points;
+    glm::vec2 point(0.0f);
+    for(int i = 0; i < waypoints; i++) {
+        point += glm::vec2(0.3f + step(rng), step(rng));
+        points.push_back(point);
+    }
+
+    VelocityLimits limits;
+    limits.maxVelocity = 2;
+    limits.maxLateralAcceleration = 1;
+    limits.maxAcceleration = 1;
+    limits.maxDeceleration = 2;
+    limits.maxJerk = 4;
+
+    double overhead = timerOverhead();
+    std::printf("%d calls per function, timer overhead %.1f ns subtracted\n", calls, overhead);
+    std::printf("%-36s %10s %10s %10s\n", "", "p50 ns", "p99 ns", "p99.9 ns");
+
+    //Paramaterized by waypoint index, so every segment is 1 wide and found with a division
+    std::vector<std::vector<CubicSplineSegment>> uniform = calculateFreeSpaceCubic(points, glm::vec2(1, 0), glm::vec2(1, 0));
+    CompiledPath uniformPath(uniform[0], uniform[1], limits, 0.01f);
+    benchPath("uniform (waypoint index)", uniformPath, rng, calls, overhead);
+
+    //Chord length paramaterization gives every segment its own width, so finding one is a binary search
+    std::vector<glm::vec2> xPoints;
+    std::vector<glm::vec2> yPoints;
+    float chord = 0;
+    for(int i = 0; i < waypoints; i++) {
+        if(i > 0) {
+            chord += glm::length(points[i] - points[i - 1]);
+        }
+        xPoints.push_back(glm::vec2(chord, points[i].x));
+        yPoints.push_back(glm::vec2(chord, points[i].y));
+    }
+    std::vector<CubicSplineSegment> xSegments = calculateCubicStitched(xPoints, 1, 1, false);
+    std::vector<CubicSplineSegment> ySegments = calculateCubicStitched(yPoints, 0, 0, false);
+    CompiledPath chordPath(xSegments, ySegments, limits, 0.01f);
+    benchPath("non-uniform (chord length)", chordPath, rng, calls, overhead);
+    return 0;
+}
@@ -0,0 +1,91 @@
+//Per path solve time of the bundled Hermite and stitched solvers at each SIMD level against solving path by path
+//Usage: pathBundleBench [paths] [waypoints] [repeats]
+#include "pathBundle.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+//Average time of one call of solve in nanoseconds, after one untimed warm up call
+template <typename Solve>
+static double timeCall(int repeats, Solve solve) {
+    solve();
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < repeats; r++) {
+        solve();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / repeats;
+}
+
+static const char *levelName(SimdLevel level) {
+    switch(level) {
+        case SimdLevel::AVX512:
+            return "AVX-512";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        default:
+            return "scalar";
+    }
+}
+
+int main(int argc, char **argv) {
+    int paths = argc > 1 ? std::atoi(argv[1]) : 4096;
+    int waypoints = argc > 2 ? std::atoi(argv[2]) : 12;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 200;
+    if(paths < 1 || waypoints < 2 || repeats < 1) {
+        std::printf("usage: pathBundleBench [paths >= 1] [waypoints >= 2] [repeats >= 1]\n");
+        return 1;
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coordinate(-1, 1);
+    std::vector<std::vector<glm::vec2>> points(paths);
+    std::vector<std::vector<glm::vec2>> slopes(paths);
+    glm::vec2 startSlope(1.0f, 0.5f);
+    glm::vec2 endSlope(0.0f, 1.0f);
+    PathBundle bundle;
+    bundle.resize(waypoints, paths);
+    for(int p = 0; p < paths; p++) {
+        for(int k = 0; k < waypoints; k++) {
+            points[p].push_back(glm::vec2(coordinate(rng), coordinate(rng)));
+            slopes[p].push_back(glm::vec2(coordinate(rng), coordinate(rng)));
+        }
+        bundle.setPath(p, points[p].data(), slopes[p].data(), startSlope, endSlope);
+    }
+
+    std::printf("%d paths of %d waypoints, %d repeats, CPU supports %s\n", paths, waypoints, repeats, levelName(detectSimdLevel()));
+    std::printf("%-28s %12s %12s\n", "", "hermite ns", "stitched ns");
+
+    //Path by path with the reentrant solvers, into storage for every path allocated up front like the bundles
+    int segments = waypoints - 1;
+    std::vector<CubicSplineSegment> xOut((size_t)paths * segments);
+    std::vector<CubicSplineSegment> yOut((size_t)paths * segments);
+    double hermite = timeCall(repeats, [&]() {
+        for(int p = 0; p < paths; p++) {
+            size_t first = (size_t)p * segments;
+            solveFreeSpaceCubicHermite(points[p].data(), slopes[p].data(), waypoints, xOut.data() + first, yOut.data() + first);
+        }
+    });
+    double stitched = timeCall(repeats, [&]() {
+        for(int p = 0; p < paths; p++) {
+            size_t first = (size_t)p * segments;
+            solveFreeSpaceCubic(points[p].data(), waypoints, startSlope, endSlope, xOut.data() + first, yOut.data() + first);
+        }
+    });
+    std::printf("%-28s %12.1f %12.1f\n", "per path", hermite / paths, stitched / paths);
+
+    SegmentBundle out;
+    for(SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "bundle %s", levelName(level));
+        if(level > detectSimdLevel()) {
+            std::printf("%-28s %12s %12s\n", name, "n/a", "n/a");
+            continue;
+        }
+        double bundledHermite = timeCall(repeats, [&]() { calculateHermiteBundle(bundle, out, level); });
+        double bundledStitched = timeCall(repeats, [&]() { calculateStitchedBundle(bundle, out, level); });
+        std::printf("%-28s %12.1f %12.1f   (%.2fx, %.2fx)\n", name, bundledHermite / paths, bundledStitched / paths, hermite / bundledHermite, stitched / bundledStitched);
+    }
+    return 0;
+}
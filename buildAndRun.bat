@@ -1,2 +1,2 @@
-g++ -g src/*.cpp src/*.c -static -Iinclude -iquote include -Llib -lopengl32 -lglfw3 -lgdi32 -o splines -mincoming-stack-boundary=2
+g++ -g -std=c++17 src/*.cpp src/*.c -static -Iinclude -iquote include -Llib -lopengl32 -lglfw3 -lgdi32 -pthread -o splines -mincoming-stack-boundary=2
 splines.exe
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include "splines.h"
+#include "threadPool.h"
+
+// Where along a path a distance lands: segment index and t = 0 to 1 within it
+struct PathLocation {
+    int segment = 0;
+    float t = 0;
+};
+
+// Distance travelled along a free space x/y path, for following it at a given speed
+// Every segment is split into samplesPerSegment equal steps of t and the length up to each step is measured with
+// 5 point Gauss-Legendre quadrature, giving one monotone table of cumulative lengths for the whole path.
+// Distance queries land on a bucket of an evenly spaced index over that table, so they take constant time,
+// then interpolate linearly inside the step and can optionally polish t with Newton steps on the exact length
+//
+// The segments are read in place by Newton refinement, so they must outlive the table (or be rebuilt with it)
+class ArcLengthTable {
+public:
+    // Segments are measured in parallel on pool when one is given
+    void build(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int count, int samplesPerSegment = 8, ThreadPool *pool = nullptr);
+
+    float totalLength() const noexcept { return lengths.empty() ? 0 : lengths.back(); }
+
+    // distance is clamped to the path. Each Newton step roughly squares the relative error of the interpolation
+    PathLocation locate(float distance, int newtonSteps = 0) const noexcept;
+    glm::vec2 positionAt(float distance, int newtonSteps = 0) const noexcept;
+
+    const std::vector<float> &table() const { return lengths; }
+    const CubicSplineSegment *xSegments() const { return xSpline; }
+    const CubicSplineSegment *ySegments() const { return ySpline; }
+
+private:
+    int samples = 8;
+    int segmentCount = 0;
+    const CubicSplineSegment *xSpline = nullptr;
+    const CubicSplineSegment *ySpline = nullptr;
+
+    // lengths[k * samples + j] is the length up to t = j / samples of segment k
+    std::vector<float> lengths;
+    // buckets[b] is the last table entry at or before distance b / bucketScale
+    std::vector<int> buckets;
+    float bucketScale = 0;
+};
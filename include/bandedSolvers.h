@@ -0,0 +1,25 @@
+#pragma once
+#include "Eigen/Core"
+
+// Solves a tridiagonal system in place with the Thomas algorithm, O(n) time and memory
+// lower(i) multiplies x(i - 1), upper(i) multiplies x(i + 1); lower(0) and upper(n - 1) are ignored
+// diag is overwritten with the eliminated diagonal and rhs with the solution
+// Takes Refs so Maps over scratch buffers work as well as VectorXd
+// No pivoting, so the system should be diagonally dominant (spline systems always are)
+// The float overloads run the whole elimination in single precision
+void solveTridiagonal(const Eigen::Ref<const Eigen::VectorXd> &lower, Eigen::Ref<Eigen::VectorXd> diag, const Eigen::Ref<const Eigen::VectorXd> &upper, Eigen::Ref<Eigen::VectorXd> rhs);
+void solveTridiagonal(const Eigen::Ref<const Eigen::VectorXf> &lower, Eigen::Ref<Eigen::VectorXf> diag, const Eigen::Ref<const Eigen::VectorXf> &upper, Eigen::Ref<Eigen::VectorXf> rhs);
+
+// Solves a cyclic tridiagonal system (periodic splines) in O(n) with the Sherman-Morrison correction
+// Same layout as solveTridiagonal except the corners wrap around: lower(0) multiplies x(n - 1)
+// and upper(n - 1) multiplies x(0). lower, diag and upper are left unchanged, rhs is overwritten with the solution
+void solveCyclicTridiagonal(const Eigen::Ref<const Eigen::VectorXd> &lower, const Eigen::Ref<const Eigen::VectorXd> &diag, const Eigen::Ref<const Eigen::VectorXd> &upper, Eigen::Ref<Eigen::VectorXd> rhs);
+void solveCyclicTridiagonal(const Eigen::Ref<const Eigen::VectorXf> &lower, const Eigen::Ref<const Eigen::VectorXf> &diag, const Eigen::Ref<const Eigen::VectorXf> &upper, Eigen::Ref<Eigen::VectorXf> rhs);
+
+// LDL^T factorization of a symmetric positive definite pentadiagonal matrix (e.g. smoothing splines), O(n)
+// diag(i) is A(i, i), first(i) is A(i, i + 1) and second(i) is A(i, i + 2); the unused tail entries are ignored
+// Overwritten with the factors: diag with D, first(i) with L(i + 1, i) and second(i) with L(i + 2, i)
+// Factoring and solving are separate so several right hand sides can share one factorization
+void factorPentadiagonal(Eigen::Ref<Eigen::VectorXd> diag, Eigen::Ref<Eigen::VectorXd> first, Eigen::Ref<Eigen::VectorXd> second);
+// Solves against factors from factorPentadiagonal, rhs is overwritten with the solution
+void solveFactoredPentadiagonal(const Eigen::Ref<const Eigen::VectorXd> &diag, const Eigen::Ref<const Eigen::VectorXd> &first, const Eigen::Ref<const Eigen::VectorXd> &second, Eigen::Ref<Eigen::VectorXd> rhs);
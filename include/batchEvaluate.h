@@ -0,0 +1,21 @@
+#pragma once
+#include "splines.h"
+
+// x and y coefficients of one free space segment back to back (32 bytes), the input layout of the batched evaluators
+struct PackedSegment {
+    float xa, xb, xc, xd;
+    float ya, yb, yc, yd;
+};
+
+PackedSegment packSegment(const CubicSplineSegment &x, const CubicSplineSegment &y);
+void packSegments(const CubicSplineSegment *x, const CubicSplineSegment *y, int count, PackedSegment *out);
+
+// Horner evaluation of many parameters at once, 8 (AVX2) or 16 (AVX-512) per fused multiply add, picked at runtime
+// with detectSimdLevel. Results come out as separate x and y arrays of count values
+
+// One segment at local parameters t = 0 to 1, e.g. the same sample grid for every segment of a path
+void evaluateSegmentBatch(const PackedSegment &segment, const float *t, int count, float *x, float *y);
+
+// A whole path at global parameters, segment k covering k to k + 1 like free space paths paramaterized by waypoint index
+// t is clamped to 0 to segmentCount. The coefficients of each lane's segment are gathered, so parameters can be in any order
+void evaluatePathBatch(const PackedSegment *segments, int segmentCount, const float *t, int count, float *x, float *y);
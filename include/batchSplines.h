@@ -0,0 +1,36 @@
+#pragma once
+#include "splines.h"
+#include "threadPool.h"
+
+// One path in a batch, read in place so the arrays must outlive the call
+struct PathInput {
+    const glm::vec2 *points = nullptr;
+    // One slope per point, only used by Hermite batches
+    const glm::vec2 *slopes = nullptr;
+    int count = 0;
+    // Only used by stitched batches
+    glm::vec2 startSlope = glm::vec2(1.0f, 0.0f);
+    glm::vec2 endSlope = glm::vec2(1.0f, 0.0f);
+};
+
+enum class BatchMode {
+    Hermite,
+    Stitched
+};
+
+// Segments of every path in a batch, stored back to back in one allocation
+// Path i owns segments offsets[i] to offsets[i + 1] of both xSegments and ySegments
+struct SplineArena {
+    std::vector<CubicSplineSegment> xSegments;
+    std::vector<CubicSplineSegment> ySegments;
+    std::vector<size_t> offsets;
+
+    size_t paths() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t segmentCount(size_t path) const { return offsets[path + 1] - offsets[path]; }
+    const CubicSplineSegment *x(size_t path) const { return xSegments.data() + offsets[path]; }
+    const CubicSplineSegment *y(size_t path) const { return ySegments.data() + offsets[path]; }
+};
+
+// Solves every path on the pool and writes the results into arena, which is sized once up front
+// Reusing the same arena across planning cycles avoids reallocating when the batch doesn't grow
+void calculateBatch(const std::vector<PathInput> &paths, BatchMode mode, SplineArena &arena, ThreadPool &pool);
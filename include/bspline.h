@@ -0,0 +1,59 @@
+#pragma once
+#include "splines.h"
+
+// Cubic B-spline / NURBS path: a knot vector and control points, with optional weights for rational curves
+// Used to exchange paths with tools that speak NURBS. Knot span j (knots[j] to knots[j + 1]) is shaped by control
+// points j - 3 to j, so moving a control point only changes the 4 spans it supports
+//
+// Only non-empty spans inside the domain (knots[3] to knots[controlPoints.size()]) become segments, in order
+class BSplinePath {
+public:
+    static const int degree = 3;
+
+    BSplinePath() {}
+    // knots needs controlPoints.size() + 4 non-decreasing values, weights is empty or one per control point
+    BSplinePath(const std::vector<double> &knots, const std::vector<glm::vec2> &controlPoints, const std::vector<double> &weights = std::vector<double>());
+
+    // Clamped uniform knots (0 0 0 0 1 2 ... n n n n), so the path starts and ends on the first and last control point
+    static BSplinePath uniform(const std::vector<glm::vec2> &controlPoints);
+    // Exact B-spline form of polynomial x/y segments (e.g. from calculateFreeSpaceCubic) by Bezier extraction
+    // Every segment becomes its 4 Bezier points with triple interior knots, segment i covering knots i to i + 1
+    static BSplinePath fromSegments(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments);
+
+    // de Boor's algorithm, u is clamped to the domain. Paths without a single span (fewer than 4 control points) give 0
+    glm::vec2 evaluate(double u) const;
+    // Many parameters at once, e.g. for tessellation
+    void evaluate(const double *u, int count, glm::vec2 *out) const;
+
+    // One x/y segment per non-empty span, t = 0 to 1 across the span
+    // Built from the value and derivative at both ends of the span, which is exact for non-rational paths
+    // and the Hermite approximation for rational ones
+    void toSegments(std::vector<CubicSplineSegment> &xSegments, std::vector<CubicSplineSegment> &ySegments) const;
+
+    // Moves control point i and rewrites only the (up to 4) segments it supports in xSegments/ySegments,
+    // which must hold the output of toSegments
+    SegmentRange setControlPoint(int i, glm::vec2 point, std::vector<CubicSplineSegment> &xSegments, std::vector<CubicSplineSegment> &ySegments);
+
+    const std::vector<double> &knotVector() const { return knots; }
+    const std::vector<glm::vec2> &points() const { return controlPoints; }
+    const std::vector<double> &pointWeights() const { return weights; }
+    int segmentCount() const { return spanStarts.size(); }
+    double domainStart() const { return knots[degree]; }
+    double domainEnd() const { return knots[controlPoints.size()]; }
+
+private:
+    int findSpan(double u) const;
+    // Value and derivative with respect to u inside span j
+    void deBoor(int j, double u, glm::dvec2 &value, glm::dvec2 &derivative) const;
+    void spanSegments(int k, CubicSplineSegment &x, CubicSplineSegment &y) const;
+
+    std::vector<double> knots;
+    std::vector<glm::vec2> controlPoints;
+    std::vector<double> weights;
+
+    // Knot index of the span behind each segment, and the segment behind each knot index (-1 for empty spans)
+    std::vector<int> spanStarts;
+    std::vector<int> spanSegment;
+    // Knot spacing when every span in the domain is the same width, which makes span lookup a division
+    double uniformStep = 0;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "velocityProfile.h"
+
+// Where a path is and which way it points. heading is the angle of the tangent in radians (atan2),
+// curvature is signed, positive when turning left
+struct PathState {
+    glm::vec2 position;
+    float heading = 0;
+    float curvature = 0;
+};
+
+// Read only x/y path for control loops: everything is laid out once at construction, after which evaluation
+// never allocates or throws and is safe to call from any number of threads
+//
+// evaluate(t) takes the segments' own parameter (segment k covers parameterOffset to parameterOffset + parameterMultiplier).
+// When every segment has the same width, as with free space paths paramaterized by waypoint index, the segment is found
+// with one division, otherwise with a binary search over the segment starts
+// evaluateAtTime(s) follows the velocity profile the path was compiled with: the profile turns the time into a distance
+// (binary search) and the arc length table turns that into a segment and t (constant time)
+class CompiledPath {
+public:
+    CompiledPath(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, int samplesPerSegment = 8);
+    CompiledPath(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, const VelocityLimits &limits, float spacing, int samplesPerSegment = 8);
+
+    // The arc length table points into xSpline/ySpline, which stay put on move but not on copy
+    CompiledPath(const CompiledPath &) = delete;
+    CompiledPath &operator=(const CompiledPath &) = delete;
+    CompiledPath(CompiledPath &&) = default;
+    CompiledPath &operator=(CompiledPath &&) = default;
+
+    // t is clamped to parameterStart() to parameterEnd()
+    PathState evaluate(float t) const noexcept;
+    // s is clamped to 0 to duration(). Without a velocity profile this is the same as evaluateAtDistance(0)
+    PathState evaluateAtTime(float s) const noexcept;
+    PathState evaluateAtDistance(float distance) const noexcept;
+
+    float parameterStart() const noexcept { return starts.empty() ? 0 : starts.front(); }
+    float parameterEnd() const noexcept { return starts.empty() ? 0 : starts.back(); }
+    float length() const noexcept { return arcLength.totalLength(); }
+    float duration() const noexcept { return velocityProfile.empty() ? 0 : velocityProfile.back().time; }
+    int segmentCount() const noexcept { return coefficients.size(); }
+
+    const ArcLengthTable &arcLengthTable() const { return arcLength; }
+    const std::vector<ProfileSample> &profile() const { return velocityProfile; }
+
+private:
+    // x and y of one segment next to each other, so an evaluation touches one cache line
+    struct Coefficients {
+        float xa, xb, xc, xd;
+        float ya, yb, yc, yd;
+    };
+
+    PathState evaluateSegment(int segment, float t) const noexcept;
+
+    std::vector<Coefficients> coefficients;
+    // Start parameter of every segment plus the end of the last one
+    std::vector<float> starts;
+    float uniformWidth = 0;
+
+    std::vector<CubicSplineSegment> xSpline;
+    std::vector<CubicSplineSegment> ySpline;
+    ArcLengthTable arcLength;
+    std::vector<ProfileSample> velocityProfile;
+};
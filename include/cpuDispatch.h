@@ -0,0 +1,18 @@
+#pragma once
+
+// Widest vector instruction set the running CPU supports, checked once at runtime
+// Kernels are built for each level with target attributes, so the build itself doesn't need -mavx2
+enum class SimdLevel {
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+SimdLevel detectSimdLevel();
+
+// GCC/Clang on x86 can build per-function ISA variants, anything else only gets the scalar kernels
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SPLINES_SIMD_DISPATCH 1
+#else
+#define SPLINES_SIMD_DISPATCH 0
+#endif
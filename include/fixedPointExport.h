@@ -0,0 +1,58 @@
+#pragma once
+#include "splines.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Paths for controllers without an FPU: every segment becomes a forward difference table in fixed point, so stepping
+// to the next sample is three integer adds (value += first, first += second, second += third) and no multiplies
+//
+// Q16.16 (int32_t, FractionBits = 16) or Q32.32 (int64_t, FractionBits = 32). Each of the four entries is rounded on
+// its own, so the rounding of third adds up like steps^3 / 6 over a segment. On unit sized segments Q16.16 is good to
+// about 1e-3 at 8 steps and falls apart past 32, Q32.32 is good to about 1e-5 at 100 steps.
+// measureFixedPointError gives the actual numbers for a path
+template <typename Int>
+struct FixedDifferences {
+    Int value, first, second, third;
+};
+
+template <typename Int, int FractionBits>
+struct FixedPointPath {
+    // Samples per segment, t = 0, 1/steps, ... (steps - 1)/steps. 0 when nothing was exported
+    int steps = 0;
+    std::vector<FixedDifferences<Int>> x;
+    std::vector<FixedDifferences<Int>> y;
+
+    static double scale() { return double(int64_t(1) << FractionBits); }
+    int segmentCount() const { return x.size(); }
+    // Every segment's samples plus the end of the last segment
+    int sampleCount() const { return x.empty() ? 0 : segmentCount() * steps + 1; }
+};
+
+typedef FixedPointPath<int32_t, 16> FixedPointPathQ16;
+typedef FixedPointPath<int64_t, 32> FixedPointPathQ32;
+
+// Returns an empty path (steps = 0) if steps < 1 or a table entry or sample could fall outside the range of Int
+template <typename Int, int FractionBits>
+FixedPointPath<Int, FractionBits> exportFixedPoint(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int count, int steps);
+
+// Host reference for the controller side: walks every table with integer adds only (wrapping like two's complement
+// hardware), so the output is bit for bit what the controller produces. Writes sampleCount() raw values to x and y
+template <typename Int, int FractionBits>
+void stepFixedPoint(const FixedPointPath<Int, FractionBits> &path, Int *x, Int *y);
+
+struct FixedPointError {
+    double maxError = 0;
+    double rmsError = 0;
+    // Worst sample, as a segment and step
+    int worstSegment = 0;
+    int worstStep = 0;
+};
+
+// Distance between every stepped sample and the double precision evaluation of the original segments at the same t
+template <typename Int, int FractionBits>
+FixedPointError measureFixedPointError(const FixedPointPath<Int, FractionBits> &path, const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments);
+
+// Writes the tables as C arrays for firmware: name_x and name_y of {value, first, second, third} plus NAME_STEPS
+template <typename Int, int FractionBits>
+void writeFixedPointSource(std::ostream &out, const FixedPointPath<Int, FractionBits> &path, const std::string &name);
@@ -0,0 +1,103 @@
+#pragma once
+#include "splines.h"
+#include <array>
+
+// Largest waypoint count that gets the unrolled fixed size solver, anything above goes through solveFreeSpaceCubic
+#define FIXED_SPLINE_MAX_UNROLLED 16
+
+// Free space spline with a waypoint count known at compile time
+// Segments live in std::arrays and the solve works on fixed size Eigen vectors on the stack, so nothing is
+// ever heap allocated. Most planned paths are only a handful of waypoints, where the allocations and the
+// generic loop overhead of the dynamic solvers cost more than the solve itself
+template <int N, typename Scalar = float>
+class FixedSpline {
+    static_assert(N >= 2, "A spline needs at least 2 waypoints");
+
+public:
+    typedef CubicSplineSegmentT<Scalar> Segment;
+    static constexpr int segmentCount = N - 1;
+
+    // Same result as solveFreeSpaceCubic
+    void solve(const Point2<Scalar> *points, Point2<Scalar> startSlope, Point2<Scalar> endSlope) {
+        if constexpr(N <= FIXED_SPLINE_MAX_UNROLLED) {
+            solveUnrolled(points, startSlope, endSlope);
+        }
+        else {
+            solveFreeSpaceCubic(points, N, startSlope, endSlope, xSpline.data(), ySpline.data());
+        }
+    }
+
+    // Same result as solveFreeSpaceCubicHermite, which never allocates so there is nothing to specialize
+    void solveHermite(const Point2<Scalar> *points, const Point2<Scalar> *slopes) {
+        solveFreeSpaceCubicHermite(points, slopes, N, xSpline.data(), ySpline.data());
+    }
+
+    const std::array<Segment, N - 1> &xSegments() const { return xSpline; }
+    const std::array<Segment, N - 1> &ySegments() const { return ySpline; }
+
+private:
+    // Every segment is 1 wide in free space, so the stitched matrix is always 2 4 4 ... 4 2 on the diagonal with
+    // 1s either side (see solveStitchedBanded). Its forward elimination only depends on N and is done at compile time
+    struct Elimination {
+        Scalar w[N] = {};
+        Scalar invDiag[N] = {};
+    };
+
+    static constexpr Elimination eliminate() {
+        Elimination e;
+        double diag = 2;
+        e.invDiag[0] = (Scalar)(1 / diag);
+        for(int i = 1; i < N; i++) {
+            double w = 1 / diag;
+            diag = (i == N - 1 ? 2 : 4) - w;
+            e.w[i] = (Scalar)w;
+            e.invDiag[i] = (Scalar)(1 / diag);
+        }
+        return e;
+    }
+
+    void solveUnrolled(const Point2<Scalar> *points, Point2<Scalar> startSlope, Point2<Scalar> endSlope) {
+        constexpr Elimination e = eliminate();
+        const int n = N - 1;
+
+        Point2<Scalar> start;
+        Point2<Scalar> end;
+        paramaterizeEndSlopes(points, N, startSlope, endSlope, start, end);
+
+        //x and y share the matrix, so they go through the sweeps together as the two columns of m
+        Eigen::Matrix<Scalar, N, 2> m;
+        m(0, 0) = 6 * (points[1].x - points[0].x - start.x);
+        m(0, 1) = 6 * (points[1].y - points[0].y - start.y);
+        for(int i = 1; i < n; i++) {
+            m(i, 0) = 6 * (points[i + 1].x - 2 * points[i].x + points[i - 1].x);
+            m(i, 1) = 6 * (points[i + 1].y - 2 * points[i].y + points[i - 1].y);
+        }
+        m(n, 0) = 6 * (end.x - (points[n].x - points[n - 1].x));
+        m(n, 1) = 6 * (end.y - (points[n].y - points[n - 1].y));
+
+        //Forward sweep, then back substitution against the all 1s upper diagonal
+        for(int i = 1; i <= n; i++) {
+            m.row(i) -= e.w[i] * m.row(i - 1);
+        }
+        m.row(n) *= e.invDiag[n];
+        for(int i = n - 1; i >= 0; i--) {
+            m.row(i) = (m.row(i) - m.row(i + 1)) * e.invDiag[i];
+        }
+
+        for(int i = 0; i < n; i++) {
+            xSpline[i] = segment(i, points[i].x, points[i + 1].x, m(i, 0), m(i + 1, 0));
+            ySpline[i] = segment(i, points[i].y, points[i + 1].y, m(i, 1), m(i + 1, 1));
+        }
+    }
+
+    static Segment segment(int i, Scalar y0, Scalar y1, Scalar m0, Scalar m1) {
+        Segment c(y0, (y1 - y0) - (2 * m0 + m1) / 6, m0 / 2, (m1 - m0) / 6);
+        c.parameterOffset = i;
+        c.outputOffset = y0;
+        c.parameterMultiplier = 1;
+        return c;
+    }
+
+    std::array<Segment, N - 1> xSpline;
+    std::array<Segment, N - 1> ySpline;
+};
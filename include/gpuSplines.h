@@ -0,0 +1,52 @@
+#pragma once
+#include "tessellate.h"
+
+// Free space path drawn by evaluating its segments in the vertex shader (Shaders/VertexSplinesGpu.vs) instead of
+// uploading samples. Segments go into a buffer texture as 2 RGBA32F texels each (x a, b, c, d then y a, b, c, d),
+// 32 bytes per segment against 1.2 KB for 100 x, y, z samples
+// Every segment gets its own sample count from its |p''| (see flatnessSteps), like PathLod, so a single hairpin
+// doesn't multiply the samples of every other segment. A second buffer texture holds the first vertex of each segment
+// (4 bytes per segment) and the vertex shader binary searches it for the segment of gl_VertexID. The path closes
+// with one more vertex at t = 1 of the last segment. Only the offsets are re-uploaded when the zoom changes, and
+// edits only re-upload them if a changed segment needs a different count
+// Buffer textures are core since GL 3.1, so this also runs on Mesa's llvmpipe for headless testing
+class GpuSplinePath {
+public:
+    // Needs a current GL context
+    void create(const char *vertexPath = "Shaders/VertexSplinesGpu.vs", const char *fragmentPath = "Shaders/FragmentSplines.fs");
+    void destroy();
+
+    void upload(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments);
+    // Re-uploads only segments first to first + count - 1, the number of segments must be unchanged
+    void updateSegments(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, int first, int count);
+
+    // Samples every segment so its chords stay within pixelTolerance pixels at a zoom
+    // pixelsPerUnit is how many pixels one world unit covers at zoom 1
+    void setZoom(float pixelsPerUnit, double zoomScaleFactor, float pixelTolerance = 0.5f);
+    void draw(const glm::mat4 &model, glm::vec3 colour);
+
+    int segmentCount() const { return segments; }
+    // Vertices the next draw evaluates
+    int vertexCount() const { return segments > 0 ? starts.back() + 1 : 0; }
+    unsigned int program() const { return shader; }
+
+private:
+    // Recounts the samples of segments first to first + count - 1, returns true if any changed
+    bool countSamples(int first, int count);
+    void uploadStarts();
+
+    GLuint coefficientBuffer = 0;
+    GLuint coefficientTexture = 0;
+    GLuint startBuffer = 0;
+    GLuint startTexture = 0;
+    GLuint vao = 0;
+    unsigned int shader = 0;
+    int segments = 0;
+    // World units a chord may stray from the curve at the current zoom
+    float tolerance = TESSELLATION_TOLERANCE;
+    // Largest |p''| and sample count of each segment
+    std::vector<float> secondDerivatives;
+    std::vector<int> samples;
+    // First vertex of every segment, then the vertex closing the path, as uploaded to startTexture
+    std::vector<int> starts = {0};
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "splines.h"
+
+// Free space Hermite path that is built up one waypoint at a time
+// Hermite segments only depend on the waypoints at either end, so appending or removing a waypoint
+// solves exactly one segment instead of regenerating the whole path
+// Only the segments are kept, drawing them (PathLod, GpuSplinePath) is up to the caller
+class HermitePath {
+public:
+    void append(glm::vec2 point, glm::vec2 slope);
+    void pop_back();
+    void clear();
+
+    // Moving a waypoint or changing its slope only touches the segments on either side of it
+    // Returns the segments that were re-solved
+    SegmentRange setPoint(size_t i, glm::vec2 point);
+    SegmentRange setSlope(size_t i, glm::vec2 slope);
+
+    bool empty() const { return waypoints.empty(); }
+    size_t size() const { return waypoints.size(); }
+
+    const std::vector<glm::vec2> &points() const { return waypoints; }
+    const std::vector<glm::vec2> &slopes() const { return waypointSlopes; }
+    const std::vector<CubicSplineSegment> &xSegments() const { return xSpline; }
+    const std::vector<CubicSplineSegment> &ySegments() const { return ySpline; }
+
+private:
+    void solveSegment(size_t i);
+    SegmentRange solveAround(size_t i);
+
+    std::vector<glm::vec2> waypoints;
+    std::vector<glm::vec2> waypointSlopes;
+    std::vector<CubicSplineSegment> xSpline;
+    std::vector<CubicSplineSegment> ySpline;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include "splines.h"
+#include "cpuDispatch.h"
+
+// Many free space paths with the same number of waypoints, stored as structure of arrays
+// Value k of path p lives at [k * paths + p], so one vector load picks up the same waypoint from
+// neighbouring paths and the solvers run 4 (AVX2) or 8 (AVX-512) paths per instruction
+struct PathBundle {
+    int waypoints = 0;
+    int paths = 0;
+    std::vector<double> x;
+    std::vector<double> y;
+    // Hermite slopes, one per waypoint
+    std::vector<double> xSlope;
+    std::vector<double> ySlope;
+    // Stitched end slopes, one per path, already paramaterized (see paramaterizeEndSlopes)
+    std::vector<double> xStart;
+    std::vector<double> yStart;
+    std::vector<double> xEnd;
+    std::vector<double> yEnd;
+
+    void resize(int waypointCount, int pathCount);
+    // slopes can be nullptr for stitched bundles, the end slopes are ignored by Hermite bundles
+    void setPath(int path, const glm::vec2 *points, const glm::vec2 *slopes, glm::vec2 startSlope, glm::vec2 endSlope);
+};
+
+// Solved coefficients, laid out like PathBundle with segment k of path p at [k * paths + p]
+struct SegmentBundle {
+    int segments = 0;
+    int paths = 0;
+    std::vector<double> xa, xb, xc, xd;
+    std::vector<double> ya, yb, yc, yd;
+    // Second derivatives at each waypoint, scratch for the stitched solver
+    std::vector<double> xCurvature;
+    std::vector<double> yCurvature;
+
+    void resize(int segmentCount, int pathCount);
+    CubicSplineSegment xSegment(int path, int k) const;
+    CubicSplineSegment ySegment(int path, int k) const;
+};
+
+// Same results as solveFreeSpaceCubicHermite and solveFreeSpaceCubic, path by path
+// Whole groups of lanes go through the widest kernel the CPU supports (capped at maxLevel, e.g. to compare kernels)
+// and leftover paths through the scalar one
+void calculateHermiteBundle(const PathBundle &in, SegmentBundle &out, SimdLevel maxLevel = SimdLevel::AVX512);
+void calculateStitchedBundle(const PathBundle &in, SegmentBundle &out, SimdLevel maxLevel = SimdLevel::AVX512);
@@ -0,0 +1,61 @@
+#pragma once
+#include "tessellate.h"
+#include <map>
+
+// View dependent tessellation of one free space path, cached per zoom level
+// Level L covers zoom factors 2^L up to 2^(L + 1) and is tessellated adaptively for the most zoomed in end of that
+// range, so every chord stays within pixelTolerance pixels of the curve anywhere in the level. Zoomed out levels get
+// a few vertices per segment, zoomed in ones as many as the on screen size of each segment needs
+// Only crossing into another level changes the vertices. Levels cache their step counts rather than vertices, so coming
+// back to one skips the flatness analysis and only reruns the forward differences, straight into the caller's memory
+// (a mapped splineBuffer region). Panning doesn't change the size of the path on screen, so it doesn't affect the level
+class PathLod {
+public:
+    // pixelsPerUnit is how many pixels one world unit covers at zoom 1
+    explicit PathLod(float pixelsPerUnit, float pixelTolerance = 0.5f);
+
+    // Copies the segments and drops every cached level
+    void setPath(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments);
+    // Segments first to first + count - 1 changed (the number of segments didn't). The other levels are dropped and
+    // the current one keeps its layout if the changed segments still need the same number of steps, otherwise it is
+    // rebuilt. Returns the vertices of the current level to rewrite with tessellate, the changed ones or all of them
+    VertexRange updateSegments(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, int first, int count);
+
+    // Moves to the level for zoomScaleFactor, returns true if that changed the current vertices
+    bool setZoom(double zoomScaleFactor);
+    static int levelFor(double zoomScaleFactor);
+    int level() const { return currentLevel; }
+    int cachedLevels() const { return levels.size(); }
+
+    // Vertices of the current level, analysed on first use
+    int vertexCount() { return currentSteps().vertexCount; }
+    // Writes the x, y, z vertices of the current level to out, which must have room for vertexCount() of them
+    void tessellate(float *out);
+    // Writes only the vertices in range (as returned by updateSegments), out points at the first of them
+    void tessellate(VertexRange range, float *out);
+
+private:
+    struct Level {
+        std::vector<int> steps;
+        // First vertex of every segment
+        std::vector<int> starts;
+        int vertexCount = 0;
+    };
+
+    Level &build(int level);
+    Level &currentSteps();
+    float tolerance(int level) const;
+
+    float pixelsPerUnit;
+    float pixelTolerance;
+    int currentLevel = 0;
+    std::vector<CubicSplineSegment> xSpline;
+    std::vector<CubicSplineSegment> ySpline;
+    std::map<int, Level> levels;
+};
+
+// Tessellates the current level straight into splineBuffer
+void generatePointsLod(PathLod &lod);
+// Rewrites only the vertices in range, the rest are carried over from the committed region on the GPU
+// splineBuffer must already hold the current level, with the same number of vertices
+void updateSplineVertices(PathLod &lod, VertexRange range);
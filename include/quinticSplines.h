@@ -0,0 +1,66 @@
+#pragma once
+#include "splines.h"
+
+// Position and its first two derivatives (with respect to t) at one point of a segment
+template <typename Scalar>
+struct SegmentState {
+    Scalar position;
+    Scalar velocity;
+    Scalar acceleration;
+};
+
+// One quintic piece, a + bt + ct^2 + dt^3 + et^4 + ft^5 for t = 0 to 1 across the segment
+// Matching position, slope and acceleration at both ends gives C2 paths with acceleration set per waypoint,
+// which cubic Hermite segments can't do
+template <typename Scalar>
+struct QuinticSplineSegmentT {
+    Scalar a, b, c, d, e, f;
+    Scalar parameterMultiplier;
+    Scalar parameterOffset, outputOffset;
+
+    QuinticSplineSegmentT(Scalar a, Scalar b, Scalar c, Scalar d, Scalar e, Scalar f) : a(a), b(b), c(c), d(d), e(e), f(f) {}
+
+    QuinticSplineSegmentT() {}
+
+    SegmentState<Scalar> evaluate(Scalar t) const {
+        SegmentState<Scalar> s;
+        s.position = a + t * (b + t * (c + t * (d + t * (e + t * f))));
+        s.velocity = b + t * (2 * c + t * (3 * d + t * (4 * e + t * 5 * f)));
+        s.acceleration = 2 * c + t * (6 * d + t * (12 * e + t * 20 * f));
+        return s;
+    }
+};
+
+typedef QuinticSplineSegmentT<float> QuinticSplineSegment;
+typedef QuinticSplineSegmentT<double> QuinticSplineSegmentd;
+
+// Closed form of the quintic Hermite system (t = 0 to 1) for values p0, p1, slopes v0, v1 and accelerations a0, a1
+// With dp = p1 - p0:
+// a = p0, b = v0, c = a0 / 2
+// d = 10dp - 6v0 - 4v1 - (3a0 - a1) / 2
+// e = -15dp + 8v0 + 7v1 + (3a0 - 2a1) / 2
+// f = 6dp - 3v0 - 3v1 - (a0 - a1) / 2
+template <typename Scalar>
+inline QuinticSplineSegmentT<Scalar> quinticHermiteSegment(Scalar p0, Scalar p1, Scalar v0, Scalar v1, Scalar a0, Scalar a1) {
+    Scalar dp = p1 - p0;
+    return QuinticSplineSegmentT<Scalar>(p0, v0, a0 / 2,
+                                         10 * dp - 6 * v0 - 4 * v1 - (3 * a0 - a1) / 2,
+                                         -15 * dp + 8 * v0 + 7 * v1 + (3 * a0 - 2 * a1) / 2,
+                                         6 * dp - 3 * v0 - 3 * v1 - (a0 - a1) / 2);
+}
+
+// Free space quintic Hermite, the quintic version of solveFreeSpaceCubicHermite
+// Slopes and accelerations are per waypoint in the waypoint index paramaterization, count - 1 segments per dimension
+template <typename Scalar>
+void solveFreeSpaceQuinticHermite(const Point2<Scalar> *points, const Point2<Scalar> *slopes, const Point2<Scalar> *accelerations, int count, QuinticSplineSegmentT<Scalar> *xOut, QuinticSplineSegmentT<Scalar> *yOut);
+
+// Same, but only the end accelerations are given and the interior ones are picked so the jerk is continuous too (C3)
+// Matching the third derivative across each waypoint gives one tridiagonal equation per interior waypoint:
+// -3a(i-1) + 18a(i) - 3a(i+1) = 60(dp(i) - dp(i-1)) + 24(v(i-1) - v(i+1)), dp(i) = p(i+1) - p(i)
+// The matrix is the same for x and y, so it is eliminated once and both go through the sweeps together
+template <typename Scalar>
+void solveFreeSpaceQuinticSmooth(const Point2<Scalar> *points, const Point2<Scalar> *slopes, int count, Point2<Scalar> startAcceleration, Point2<Scalar> endAcceleration,
+                                 QuinticSplineSegmentT<Scalar> *xOut, QuinticSplineSegmentT<Scalar> *yOut);
+
+std::vector<std::vector<QuinticSplineSegment>> calculateFreeSpaceQuinticHermite(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &slopes, const std::vector<glm::vec2> &accelerations);
+std::vector<std::vector<QuinticSplineSegment>> calculateFreeSpaceQuinticSmooth(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &slopes, glm::vec2 startAcceleration, glm::vec2 endAcceleration);
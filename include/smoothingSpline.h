@@ -0,0 +1,17 @@
+#pragma once
+#include "splines.h"
+
+// Smoothing splines for noisy waypoints (e.g. recorded odometry), where passing through every point gives a wiggly path
+// Fits the natural cubic spline g minimizing sum(w(i)(y(i) - g(x(i)))^2) + lambda * integral(g''(x)^2)
+// lambda = 0 interpolates every point, larger values trade closeness for smoothness and lambda -> infinity
+// gives the weighted least squares line. weights can be empty (all 1), otherwise one positive weight per point
+//
+// Solved with Reinsch's algorithm: the second derivatives at the interior points come out of one symmetric
+// positive definite pentadiagonal system, (R + lambda Q^T W^-1 Q)M = Q^T y, factored with LDL^T in O(n)
+
+// 1D fit, x values must be strictly increasing
+std::vector<CubicSplineSegment> calculateCubicSmoothing(const std::vector<glm::vec2> &points, double lambda, const std::vector<float> &weights = std::vector<float>());
+
+// Free space fit paramaterized by waypoint index like calculateFreeSpaceCubic
+// x and y share one factorization and go through it as two right hand sides
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicSmoothing(const std::vector<glm::vec2> &points, double lambda, const std::vector<float> &weights = std::vector<float>());
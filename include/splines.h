@@ -1,9 +1,11 @@
 #pragma once
 #include "Eigen/Dense"
+#include "Eigen/Sparse"
 #include <cmath>
 #include <glm/glm.hpp>
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
+#include "streamBuffer.h"
 #include <vector>
 
 #define RANGE 20
@@ -12,19 +14,93 @@ struct ControlPoint {
     float x, y, angle;
 };
 
-struct CubicSplineSegment {
-    float a, b, c, d;
-    float parameterMultiplier;
-    float parameterOffset, outputOffset;
+// One cubic piece, a + bt + ct^2 + dt^3 for t = 0 to 1 across the segment
+// Scalar is float for throughput (rendering, embedded consumers) or double where float positions run out
+// of precision (large maps). The solvers below are templated the same way and run entirely in Scalar
+template <typename Scalar>
+struct CubicSplineSegmentT {
+    Scalar a, b, c, d;
+    Scalar parameterMultiplier;
+    Scalar parameterOffset, outputOffset;
 
-    CubicSplineSegment(const Eigen::Vector4d &v) {
+    template <typename Derived>
+    CubicSplineSegmentT(const Eigen::MatrixBase<Derived> &v) {
         a = v[0];
         b = v[1];
         c = v[2];
         d = v[3];
     }
 
-    CubicSplineSegment() {}
+    CubicSplineSegmentT(Scalar a, Scalar b, Scalar c, Scalar d) : a(a), b(b), c(c), d(d) {}
+
+    // Converts between precisions, e.g. to narrow segments solved in double
+    template <typename Other>
+    explicit CubicSplineSegmentT(const CubicSplineSegmentT<Other> &s)
+        : a(s.a), b(s.b), c(s.c), d(s.d), parameterMultiplier(s.parameterMultiplier), parameterOffset(s.parameterOffset), outputOffset(s.outputOffset) {}
+
+    CubicSplineSegmentT() {}
+
+    Scalar evaluate(Scalar t) const {
+        return a + t * (b + t * (c + t * d));
+    }
+};
+
+typedef CubicSplineSegmentT<float> CubicSplineSegment;
+typedef CubicSplineSegmentT<double> CubicSplineSegmentd;
+
+template <typename Scalar>
+using Point2 = glm::tvec2<Scalar, glm::defaultp>;
+
+// Closed form of the cubic Hermite system (t = 0 to 1) for values p0, p1 and slopes m0, m1
+// a = p0, b = m0, c = 3(p1 - p0) - 2m0 - m1, d = 2(p0 - p1) + m0 + m1
+template <typename Scalar>
+inline CubicSplineSegmentT<Scalar> hermiteSegment(Scalar p0, Scalar p1, Scalar m0, Scalar m1) {
+    Scalar dp = p1 - p0;
+    return CubicSplineSegmentT<Scalar>(p0, m0, 3 * dp - 2 * m0 - m1, m0 + m1 - 2 * dp);
+}
+
+// Span of vertices (not floats) that changed in a sampled path, used to retessellate only part of a path
+struct VertexRange {
+    int first = 0;
+    int count = 0;
+};
+
+// Range of segments (not vertices) that changed
+struct SegmentRange {
+    int first = 0;
+    int count = 0;
+};
+
+// How calculateCubicStitched solves the C1/C2 stitching conditions
+// Dense: full 4(n-1) x 4(n-1) system, O(n^3), kept as a reference
+// Banded: tridiagonal second-derivative formulation, O(n), solved in double and narrowed at the end
+// BandedFloat: the same solve entirely in float, faster but with less precision on large coordinates
+// Sparse: full system assembled from triplets and solved with SparseLU
+enum class StitchedSolver {
+    Dense,
+    Banded,
+    Sparse,
+    BandedFloat
+};
+
+// Sparse backend for the stitched system that can be kept around between solves
+// The symbolic analysis is only redone when the number of points changes,
+// so moving points only costs a numeric refactorization
+class SparseStitchedSolver {
+public:
+    std::vector<CubicSplineSegment> solve(const std::vector<glm::vec2> &points, float startSlope, float endSlope);
+    // Free space x and y (paramaterized by waypoint index, so xPoints and yPoints share their x values)
+    // Both go through one factorization as the two columns of the right hand side
+    std::vector<std::vector<CubicSplineSegment>> solveFreeSpace(const std::vector<glm::vec2> &xPoints, const std::vector<glm::vec2> &yPoints, glm::vec2 start, glm::vec2 end);
+
+private:
+    void factorize(const std::vector<glm::vec2> &points);
+
+    Eigen::SparseMatrix<double> mat;
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> lu;
+    std::vector<Eigen::Triplet<double>> entries;
+    Eigen::MatrixXd y;
+    int analyzedSize = -1;
 };
 
 // Spline data
@@ -37,16 +113,38 @@ extern std::vector<CubicSplineSegment> yCubicSpline;
 extern float numberOfPoints;
 
 // GL containers
-extern GLuint splineVBO;
 extern GLuint splineVAO;
-extern GLuint pointsVBO;
 extern GLuint pointsVAO;
+extern StreamBuffer splineBuffer;
+extern StreamBuffer pointsBuffer;
 
+void generateControlPointVertices();
 void generatePointsCubic();
 void generatePointsFreeSpaceCubic();
 void calculateCubic(std::vector<glm::vec2> points);
-std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> points, float startSlope, float endSlope, bool linear);
-std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubic(std::vector<glm::vec2> points, glm::vec2 startSlope, glm::vec2 endSlope);
-std::vector<CubicSplineSegment> calculateCubicHermite(std::vector<glm::vec2> points, std::vector<float> slopes);
-std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicHermite(std::vector<glm::vec2> points, std::vector<glm::vec2> slopes);
-std::vector<CubicSplineSegment> calculateCubicHermite1Dimensional(std::vector<glm::vec2> points, std::vector<glm::vec2> slopes);
\ No newline at end of file
+std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> points, float startSlope, float endSlope, bool linear, StitchedSolver solver = StitchedSolver::Banded);
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubic(std::vector<glm::vec2> points, glm::vec2 startSlope, glm::vec2 endSlope, StitchedSolver solver = StitchedSolver::Banded);
+// Closed loops: one segment per point, the last one joining back to the first with C1/C2 continuity
+// Don't repeat the first point at the end. For the 1D version the loop closes period after the first x
+std::vector<CubicSplineSegment> calculateCubicPeriodic(const std::vector<glm::vec2> &points, float period);
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicPeriodic(const std::vector<glm::vec2> &points);
+std::vector<CubicSplineSegment> calculateCubicHermite(const std::vector<glm::vec2> &points, const std::vector<float> &slopes);
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicHermite(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &slopes);
+std::vector<CubicSplineSegment> calculateCubicHermite1Dimensional(std::vector<glm::vec2> points, std::vector<glm::vec2> slopes);
+
+// Reentrant free space solvers that write count - 1 segments per dimension into caller owned storage
+// No globals are touched, so they can run on many paths at once
+// Instantiated for float (glm::vec2, CubicSplineSegment) and double (glm::dvec2, CubicSplineSegmentd)
+// The float versions are the single precision fast path, calculateFreeSpaceCubic solves in double unless asked not to
+template <typename Scalar>
+void solveFreeSpaceCubic(const Point2<Scalar> *points, int count, Point2<Scalar> startSlope, Point2<Scalar> endSlope, CubicSplineSegmentT<Scalar> *xOut, CubicSplineSegmentT<Scalar> *yOut);
+// Same solve for any number of dimensions (e.g. x, y, z, heading), which all share one factorization
+// Waypoint k is points[k * Dims] to points[k * Dims + Dims - 1], so arrays of glm vectors can be passed directly
+// startSlope and endSlope hold Dims values, out holds Dims pointers to count - 1 segments each
+// Instantiated for Dims = 2, 3 and 4 in float and double
+template <int Dims, typename Scalar>
+void solveFreeSpaceCubicN(const Scalar *points, int count, const Scalar *startSlope, const Scalar *endSlope, CubicSplineSegmentT<Scalar> *const *out);
+template <typename Scalar>
+void solveFreeSpaceCubicHermite(const Point2<Scalar> *points, const Point2<Scalar> *slopes, int count, CubicSplineSegmentT<Scalar> *xOut, CubicSplineSegmentT<Scalar> *yOut);
+template <typename Scalar>
+void paramaterizeEndSlopes(const Point2<Scalar> *points, int count, Point2<Scalar> startSlope, Point2<Scalar> endSlope, Point2<Scalar> &start, Point2<Scalar> &end);
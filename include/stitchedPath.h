@@ -0,0 +1,48 @@
+#pragma once
+#include "splines.h"
+
+// Free space stitched (C2) spline that can be edited one waypoint at a time
+// Both dimensions are paramaterized by waypoint index and the start/end slopes are in the same units
+// (change per waypoint), so every segment is 1 wide and the x and y systems share one matrix
+//
+// Unlike Hermite paths, moving one waypoint changes every segment, but the change dies off geometrically
+// (by about 2 - sqrt(3) per waypoint). Edits solve for the change over a window around the waypoint and
+// bound the error from cutting the window off, only falling back to a full solve when the bound gets too big
+class StitchedPath {
+public:
+    void solve(const std::vector<glm::vec2> &points, glm::vec2 startSlope, glm::vec2 endSlope);
+
+    // Returns the vertices that were resampled
+    // tolerance is the largest position error the windowed correction may leave behind
+    VertexRange setPoint(size_t i, glm::vec2 point, float tolerance = 1e-4f);
+    VertexRange setStartSlope(glm::vec2 slope, float tolerance = 1e-4f);
+    VertexRange setEndSlope(glm::vec2 slope, float tolerance = 1e-4f);
+
+    // Upper bound on how far the current segments can be from a full re-solve
+    double errorBound() const { return accumulatedError; }
+
+    const std::vector<glm::vec2> &points() const { return waypoints; }
+    const std::vector<CubicSplineSegment> &xSegments() const { return xSpline; }
+    const std::vector<CubicSplineSegment> &ySegments() const { return ySpline; }
+    const std::vector<float> &vertices() const { return splinePoints; }
+    int vertexCount() const { return splinePoints.size() / 3; }
+
+private:
+    VertexRange correct(int first, int last, const Eigen::VectorXd &xChange, const Eigen::VectorXd &yChange, float tolerance);
+    void solveSegment(int i);
+    VertexRange resample(int first, int last);
+
+    std::vector<glm::vec2> waypoints;
+    glm::vec2 start;
+    glm::vec2 end;
+    // Second derivative at each waypoint
+    Eigen::VectorXd xCurvature;
+    Eigen::VectorXd yCurvature;
+    double accumulatedError = 0;
+
+    std::vector<CubicSplineSegment> xSpline;
+    std::vector<CubicSplineSegment> ySpline;
+    std::vector<float> splinePoints;
+    // Every segment gets the same number of samples, and the end of the path one more vertex
+    int samplesPerSegment = 0;
+};
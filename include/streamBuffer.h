@@ -0,0 +1,71 @@
+#pragma once
+#include <glad/glad.h>
+
+// Vertex buffer that is written through a mapped pointer instead of reallocated with glBufferData on every change
+// The storage is split into 3 equal regions used in turn, so the CPU fills one while the GPU can still be drawing
+// from the others. Every draw fences the region it read, and a region is only written again once its fence has
+// signalled, which with 3 regions has nearly always happened already. Regions double in size when a write doesn't
+// fit, so regenerating a path only reaches the allocator a handful of times over a session
+// Edits that only change part of the vertices carry the rest over from the committed region with a GPU side copy,
+// so only the changed vertices are written from the CPU
+//
+// With GL 4.4 or ARB_buffer_storage the storage is immutable and mapped once, persistent and coherent. Otherwise
+// every write maps just its region with glMapBufferRange, unsynchronized because the fence already says the GPU is
+// done with it. Vertices are floatsPerVertex floats for attribute 0 of the VAO given to create
+class StreamBuffer {
+public:
+    // glad.c is only generated up to GL 4.0, so glBufferStorage is looked up here, once after gladLoadGLLoader
+    // Buffers created without it (or on drivers without buffer storage) use the glMapBufferRange fallback
+    static void loadBufferStorage(GLADloadproc load);
+
+    // Needs a current GL context. Points attribute 0 of vao at this buffer
+    void create(GLuint vao, int floatsPerVertex = 3);
+    void destroy();
+
+    // Room for count vertices in the next region, only valid until commit
+    float *map(int count);
+    // Partial update: the next region starts out as a copy of the committed vertices, made on the GPU, except for
+    // rangeCount vertices from first, which are left for the caller to write through the returned pointer
+    float *mapRange(int first, int rangeCount);
+    // Finishes the write started by map or mapRange, the vertices written become the ones drawn
+    void commit();
+    // map, copy and commit, for data that already lives somewhere else
+    void upload(const float *vertices, int count);
+
+    // Draws the committed vertices starting at first() and fences the region they are in
+    void draw(GLenum mode);
+
+    int vertexCount() const { return count; }
+    // First vertex of the committed region, for drawing from it with other calls
+    int first() const { return current * regionVertices; }
+    int capacity() const { return regionVertices; }
+    bool persistent() const { return persistentMapping; }
+
+private:
+    static const int regions = 3;
+
+    // Grows every region to hold at least count vertices
+    void reserve(int count);
+    void waitForRegion(int region);
+    // Fences everything the GPU has been asked to do with a region so far
+    void fenceRegion(int region);
+    // Starts a write of rangeCount vertices from first in region, count vertices in total
+    float *mapRegion(int region, int first, int rangeCount, int count);
+
+    GLuint buffer = 0;
+    GLuint vao = 0;
+    int floatsPerVertex = 3;
+    bool persistentMapping = false;
+    // Whole storage when persistently mapped
+    float *storage = nullptr;
+    int regionVertices = 0;
+
+    int current = 0;
+    int count = 0;
+    // Region and size of a map that hasn't been committed yet, -1 when there is none
+    int pendingRegion = -1;
+    int pendingCount = 0;
+    // Whether the pending write went through glMapBufferRange and needs unmapping
+    bool mapped = false;
+    GLsync fences[regions] = {};
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include "splines.h"
+
+// How TangentStream picks the slope at each waypoint from its neighbours
+// CatmullRom: half the chord between the previous and next waypoint
+// Cardinal: Catmull-Rom scaled by (1 - tension), tension 1 gives straight lines (the one sided end tangents too)
+// Centripetal: Catmull-Rom over knots spaced by the square root of the chord length, which avoids cusps and
+// self intersections when waypoints bunch up
+enum class TangentMode {
+    CatmullRom,
+    Cardinal,
+    Centripetal
+};
+
+// Free space Hermite path with automatic tangents, for waypoints that come from a planner instead of the editor
+// Waypoints go in one at a time. A waypoint's tangent only depends on its neighbours, so with one waypoint of
+// lookahead each segment is final as soon as the waypoint after its end arrives and is handed out straight away.
+// Only the last three waypoints are kept, so routes of any length can be streamed through
+// Segments are paramaterized by waypoint index like solveFreeSpaceCubicHermite
+class TangentStream {
+public:
+    explicit TangentStream(TangentMode mode = TangentMode::CatmullRom, float tension = 0);
+
+    // Returns true and writes the segment ending at the previous waypoint once one has been finalized
+    bool push(glm::vec2 point, CubicSplineSegment &xOut, CubicSplineSegment &yOut);
+    // Closes the route, the last waypoint gets a one sided tangent
+    // Returns true and writes the last segment if there was one, then resets for the next route
+    bool finish(CubicSplineSegment &xOut, CubicSplineSegment &yOut);
+    void reset();
+
+    // Waypoints pushed since the last reset
+    size_t size() const { return count; }
+
+private:
+    float knotSpacing(glm::vec2 from, glm::vec2 to) const;
+    // Applies the mode's scale to a tangent, (1 - tension) for Cardinal
+    glm::vec2 scaled(glm::vec2 tangent) const;
+    void emit(size_t segment, glm::vec2 endTangent, CubicSplineSegment &xOut, CubicSplineSegment &yOut);
+
+    TangentMode mode;
+    float tension;
+
+    size_t count = 0;
+    // The two most recent waypoints, the tangent at previous and the knot spacing between them
+    glm::vec2 previous;
+    glm::vec2 current;
+    glm::vec2 previousTangent;
+    float spacing = 1;
+};
+
+// Runs a whole set of waypoints through a TangentStream
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceTangentSpline(const std::vector<glm::vec2> &points, TangentMode mode, float tension = 0);
@@ -0,0 +1,46 @@
+#pragma once
+#include "splines.h"
+
+// Samples per segment for drawing paths that are edited in place, which need the same count for every segment
+#define TESSELLATION_STEPS 100
+// Largest distance in world units between a drawn chord and the curve for adaptive tessellation
+// The 800 pixel window spans 2 units at the default zoom, so this is under half a pixel
+#define TESSELLATION_TOLERANCE 0.001f
+// Cap on adaptive steps per segment, in case of huge or degenerate segments
+#define TESSELLATION_MAX_STEPS 1024
+
+// Segments are sampled at t = 0, 1/steps, ... (steps - 1)/steps with third order forward differences, so after the
+// first sample every vertex costs three adds per dimension. Every segment starts from its own a, so errors from the
+// running sums never carry over into the next segment, and the end of a path is evaluated exactly at t = 1
+// Vertices are x, y, z (z = 0) floats laid out for splineBuffer
+
+// Vertices a path of segmentCount segments tessellates to, every segment's samples plus the end of the last one
+inline int tessellatedVertexCount(int segmentCount, int steps) {
+    return segmentCount > 0 ? segmentCount * steps + 1 : 0;
+}
+
+// Writes steps vertices (3 * steps floats) of one segment to out
+void tessellateSegment(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment, int steps, float *out);
+// Writes the vertex at t = 1 of a segment to out
+void segmentEndVertex(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment, float *out);
+
+// Writes a whole path to out, which must hold 3 * tessellatedVertexCount(segmentCount, steps) floats
+// Returns the number of vertices written
+int tessellatePath(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segmentCount, int steps, float *out);
+
+// Adaptive tessellation: each segment gets the fewest even steps that keep every chord within tolerance of the curve
+// A chord over a t interval of width w strays at most w^2/8 * max|p''| from the curve, and p'' of a cubic is linear
+// in t so its largest length is at one of the ends. Straight runs get 1 step, tight turns as many as they need
+
+// Largest |p''| over a segment
+float maxSecondDerivative(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment);
+// Steps for a segment whose |p''| is at most secondDerivative, between 1 and maxSteps
+// tolerance should be positive, a straight segment always gets 1 step and any other gets maxSteps if it isn't
+int flatnessSteps(float secondDerivative, float tolerance, int maxSteps = TESSELLATION_MAX_STEPS);
+int flatnessSteps(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment, float tolerance, int maxSteps = TESSELLATION_MAX_STEPS);
+
+// Fills steps (one per segment) and returns the number of vertices tessellatePathAdaptive will write
+int adaptiveVertexCount(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segmentCount, float tolerance, int *steps);
+
+// Like tessellatePath with each segment's own step count, out must hold 3 * adaptiveVertexCount floats
+int tessellatePathAdaptive(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segmentCount, const int *steps, float *out);
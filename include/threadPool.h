@@ -0,0 +1,50 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for running independent jobs over a range of indices
+// Each worker starts with an even share of the range. When it runs out it steals the back half of
+// whatever another worker has left, so uneven jobs (e.g. paths of very different lengths) still balance out
+class ThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(unsigned int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Calls task(i) for every i in [0, count) and returns once they have all finished
+    // The calling thread works too; task must not throw
+    // Only one parallelFor may run on a pool at a time
+    void parallelFor(size_t count, const std::function<void(size_t)> &task);
+
+    unsigned int size() const { return workerCount; }
+
+private:
+    struct WorkRange {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void workerLoop(unsigned int id);
+    void runTasks(unsigned int id);
+    bool takeTask(unsigned int id, size_t &index);
+
+    unsigned int workerCount;
+    std::unique_ptr<WorkRange[]> ranges;
+    std::vector<std::thread> workers;
+
+    std::mutex jobLock;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    const std::function<void(size_t)> *task = nullptr;
+    size_t generation = 0;
+    unsigned int busyWorkers = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "arcLength.h"
+
+// What the robot can do. Decelerations and the jerk limit are magnitudes, a jerk limit of 0 means unlimited
+struct VelocityLimits {
+    float maxVelocity = 1;
+    float maxLateralAcceleration = 1;
+    float maxAcceleration = 1;
+    float maxDeceleration = 1;
+    float maxJerk = 0;
+    float startVelocity = 0;
+    float endVelocity = 0;
+};
+
+// One point of a profile, everything along the path
+struct ProfileSample {
+    float distance = 0;
+    float velocity = 0;
+    float acceleration = 0;
+    float time = 0;
+};
+
+// Time optimal speed along a free space x/y path under velocity, lateral acceleration (v^2 * curvature),
+// longitudinal acceleration and jerk limits
+// The path is sampled once on an evenly spaced arc length grid (spacing is rounded so the last sample lands on the end).
+// Curvature caps the speed at every sample, then a backward pass makes every sample reachable by braking into the next
+// and a forward pass makes it reachable by accelerating out of the previous one, both in linear time
+//
+// Jerk is limited approximately: the acceleration used for a step may only build up by maxJerk times the time the
+// previous step took. Dropping back off the acceleration (e.g. on reaching a speed cap) is not limited
+std::vector<ProfileSample> calculateVelocityProfile(const ArcLengthTable &path, const VelocityLimits &limits, float spacing);
+
+// Interpolates the profile at a time between 0 and profile.back().time
+// distance can go straight into ArcLengthTable::locate to find where the robot should be
+ProfileSample sampleProfile(const std::vector<ProfileSample> &profile, float time) noexcept;
@@ -11,6 +11,9 @@
 #include <GLFW/stb_image.h>
 #include <vector>
 #include <splines.h>
+#include <hermitePath.h>
+#include <pathLod.h>
+#include <gpuSplines.h>
 #include <chrono>
 ///VBOs Vertex Buffer Objects contain vertex data that is sent to memory in the GPU, vertex attrib calls config bound VBO
 ///VAOs Vertex Array Objects when bound, any vertex attribute calls and attribute configs are stored in VAO
@@ -50,7 +53,7 @@ bool firstPoint = true;
 bool tabPressed = false;
 bool shiftPressed = false;
 unsigned int slopeVAO;
-unsigned int slopeVBO;
+StreamBuffer slopeBuffer;
 float slopePoints[] {1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
 unsigned int textShader = 0;
 unsigned int initialSlopeText; //Texture 0
@@ -62,11 +65,34 @@ glm::vec2 endSlope = glm::vec2(0.0f);
 
 bool configureSlope = false;
 
+//Waypoints that have their slope set, solved incrementally as they are added
+HermitePath hermitePath;
+//What is actually drawn, tessellated for the current zoom (800 pixels span 2 units at zoom 1)
+PathLod pathLod(dimension / 2);
+//Same path evaluated in the vertex shader from its coefficients, opted into with G
+GpuSplinePath gpuPath;
+bool gpuSplines = false;
+//Waypoint being moved with ctrl + left click, -1 when nothing is grabbed
+int draggedPoint = -1;
+const float grabRadius = 0.03f;
+
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
 	glViewport(0, 0, width, height);
 }
 
+//Hands the whole path to whichever renderer is drawing it
+void uploadPath() {
+	if(gpuSplines) {
+		gpuPath.upload(hermitePath.xSegments(), hermitePath.ySegments());
+		generateControlPointVertices();
+	}
+	else {
+		pathLod.setPath(hermitePath.xSegments(), hermitePath.ySegments());
+		generatePointsLod(pathLod);
+	}
+}
+
 glm::vec2 screenToWorldCoordinates(glm::vec2 screenPos) {
 	float xpos = screenPos.x;
 	float ypos = screenPos.y;
@@ -92,6 +118,11 @@ void scroll_callback(GLFWwindow *window, double xoffset, double yoffset) {
 		zoom = glm::scale(zoom, glm::vec3(1.0f - zoomStep));
 		zoomScaleFactor *= (1 - zoomStep);
 	}
+	//Only crossing into another level retessellates (or pulls it from the cache)
+	//The GPU path picks its samples from the zoom every frame
+	if(pathLod.setZoom(zoomScaleFactor) && !gpuSplines) {
+		generatePointsLod(pathLod);
+	}
 }
 
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods) {
@@ -102,9 +133,7 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
 
 		glm::vec2 lastPoint = controlPoints.back();
 		slopePoints[0] = lastPoint.x; slopePoints[1] = lastPoint.y;
-		glBindVertexArray(slopeVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, slopeVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(slopePoints), slopePoints, GL_DYNAMIC_DRAW);
+		slopeBuffer.upload(slopePoints, 2);
 	}
 	else if(glfwGetKey(window, GLFW_KEY_LEFT_SHIFT)) {
 		shiftPressed = true;
@@ -113,18 +142,26 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
 
 		glm::vec2 firstPoint = controlPoints.front();
 		slopePoints[0] = firstPoint.x; slopePoints[1] = firstPoint.y;
-		glBindVertexArray(slopeVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, slopeVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(slopePoints), slopePoints, GL_DYNAMIC_DRAW);
+		slopeBuffer.upload(slopePoints, 2);
 	}
-	if(glfwGetKey(window, GLFW_KEY_Z)) {
-		controlPoints.erase(controlPoints.end());
-		controlSlopes.erase(controlSlopes.end());
+	if(glfwGetKey(window, GLFW_KEY_Z) && !controlPoints.empty()) {
+		//A point still waiting for its slope isn't part of the path yet
+		if(configureSlope) {
+			configureSlope = false;
+		}
+		else if(!controlSlopes.empty()) {
+			controlSlopes.pop_back();
+			hermitePath.pop_back();
+		}
+		controlPoints.pop_back();
+		//Undo ends any drag, the dragged waypoint may be the one that was just removed
+		draggedPoint = -1;
 		// std::vector<std::vector<CubicSplineSegment>> xySplines = calculateFreeSpaceCubic(controlPoints, startSlope, endSlope);
-		std::vector<std::vector<CubicSplineSegment>> xySplines = calculateFreeSpaceCubicHermite(controlPoints, controlSlopes);
-		xCubicSpline = xySplines[0];
-		yCubicSpline = xySplines[1];
-		generatePointsFreeSpaceCubic();
+		uploadPath();
+	}
+	if(key == GLFW_KEY_G && action == GLFW_PRESS) {
+		gpuSplines = !gpuSplines;
+		uploadPath();
 	}
 }
 
@@ -136,19 +173,59 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos) {
 		pan = glm::translate(pan, glm::vec3(newPan, 0.0f));
 		rightMouseRef = newMouse;
 	}
+	if(draggedPoint >= 0 && draggedPoint < (int)hermitePath.size()) {
+		//Only the segments touching the waypoint are re-solved and re-uploaded
+		glm::vec2 mousePoint = screenToWorldCoordinates(xpos, ypos) + panOffset;
+		controlPoints[draggedPoint] = mousePoint;
+		//The segments on either side of the waypoint changed, if they still need as many vertices they're patched in place
+		SegmentRange changed = hermitePath.setPoint(draggedPoint, mousePoint);
+		if(gpuSplines) {
+			gpuPath.updateSegments(hermitePath.xSegments(), hermitePath.ySegments(), changed.first, changed.count);
+			generateControlPointVertices();
+		}
+		else {
+			int before = pathLod.vertexCount();
+			VertexRange vertices = pathLod.updateSegments(hermitePath.xSegments(), hermitePath.ySegments(), changed.first, changed.count);
+			//Same layout, so only the changed segments are written, otherwise the level was rebuilt
+			if(pathLod.vertexCount() == before && vertices.count < before) {
+				updateSplineVertices(pathLod, vertices);
+				generateControlPointVertices();
+			}
+			else {
+				generatePointsLod(pathLod);
+			}
+		}
+	}
 	if(shiftPressed || tabPressed || configureSlope) {
 		glm::vec2 mousePoint = screenToWorldCoordinates(xpos, ypos) + panOffset;
 		slopePoints[3] = mousePoint.x; slopePoints[4] = mousePoint.y;
-		glBindVertexArray(slopeVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, slopeVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(slopePoints), slopePoints, GL_DYNAMIC_DRAW);
+		slopeBuffer.upload(slopePoints, 2);
 	}
 }
 
 void mouse_button_callback(GLFWwindow *window, int button, int action, int mods) {
 	if (button == GLFW_MOUSE_BUTTON_LEFT)
 	{
-		if (action == GLFW_PRESS)
+		if (action == GLFW_RELEASE) {
+			draggedPoint = -1;
+		}
+
+		//Grab the closest waypoint instead of placing a new one
+		if (action == GLFW_PRESS && (mods & GLFW_MOD_CONTROL) && !configureSlope)
+		{
+			double xpos, ypos;
+			glfwGetCursorPos(window, &xpos, &ypos);
+			glm::vec2 gridPos = screenToWorldCoordinates(xpos, ypos) + panOffset;
+			float closest = grabRadius / zoomScaleFactor;
+			for (int i = 0; i < (int)hermitePath.size(); i++) {
+				float distance = glm::length(hermitePath.points()[i] - gridPos);
+				if (distance < closest) {
+					closest = distance;
+					draggedPoint = i;
+				}
+			}
+		}
+		else if (action == GLFW_PRESS)
 		{
 			if (firstPoint) {
 				firstPoint = false;
@@ -189,25 +266,28 @@ void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
 				glm::vec2 lastPoint = gridPos;
 				slopePoints[0] = lastPoint.x; slopePoints[1] = lastPoint.y;
 				slopePoints[2] = lastPoint.x; slopePoints[3] = lastPoint.y;
-				glBindVertexArray(slopeVAO);
-				glBindBuffer(GL_ARRAY_BUFFER, slopeVBO);
-				glBufferData(GL_ARRAY_BUFFER, sizeof(slopePoints), slopePoints, GL_DYNAMIC_DRAW);
+				slopeBuffer.upload(slopePoints, 2);
 			}
 			else {
 				configureSlope = false;
 				controlSlopes.push_back(gridPos - controlPoints.back());
 				// std::vector<std::vector<CubicSplineSegment>> xySplines = calculateFreeSpaceCubic(controlPoints, startSlope, endSlope);
 			}
+
+			//New points don't change the path until their slope is set
+			if(configureSlope) {
+				generateControlPointVertices();
+				return;
+			}
+
 			auto start = std::chrono::high_resolution_clock::now();
 			// std::vector<std::vector<CubicSplineSegment>> xySplines = calculateFreeSpaceCubic(controlPoints, startSlope, endSlope);
-			std::vector<std::vector<CubicSplineSegment>> xySplines = calculateFreeSpaceCubicHermite(controlPoints, controlSlopes);
 			// cubicSpline = calculateCubicHermite1Dimensional(controlPoints, controlSlopes);
-			xCubicSpline = xySplines[0];
-			yCubicSpline = xySplines[1];
+			hermitePath.append(controlPoints.back(), controlSlopes.back());
 			auto end = std::chrono::high_resolution_clock::now();
 			auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
-			generatePointsFreeSpaceCubic();
+			uploadPath();
 			// generatePointsCubic();
 			// std::cout << duration << std::endl;
 		}
@@ -246,6 +326,7 @@ int main()
 		std::cout << "Failed to initialize GLAD" << std::endl;
 		return -1;
 	}
+	StreamBuffer::loadBufferStorage((GLADloadproc)glfwGetProcAddress);
 
 	//Set size of rendering window
 	glViewport(0, 0, dimension, dimension);
@@ -255,12 +336,8 @@ int main()
 	
 	//Drawing the line from point to cursor for slope
 	glGenVertexArrays(1, &slopeVAO);
-	glBindVertexArray(slopeVAO);
-	glGenBuffers(1, &slopeVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, slopeVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(slopePoints), slopePoints, GL_DYNAMIC_DRAW);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-	glEnableVertexAttribArray(0);
+	slopeBuffer.create(slopeVAO);
+	slopeBuffer.upload(slopePoints, 2);
 
 	//Create a Vertex Array Object
 	unsigned int textVAO;
@@ -313,48 +390,31 @@ int main()
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)(3 * sizeof(float)));
 	glEnableVertexAttribArray(1);
 
-	//Create a Vertex Array Object
+	//Create a Vertex Array Object, the buffer behind it is mapped and written in place from then on
 	glGenVertexArrays(1, &splineVAO);
-	glBindVertexArray(splineVAO);
-
-	std::vector<float> splinePoints;
-	for (float x = -RANGE; x <= RANGE; x += 0.1) {
-		splinePoints.push_back(x);
-		splinePoints.push_back(x * x * x);
-		splinePoints.push_back(0.0f);
+	splineBuffer.create(splineVAO);
+
+	int cubicPoints = (int)(2 * RANGE / 0.1) + 1;
+	float *splinePoints = splineBuffer.map(cubicPoints);
+	for (int i = 0; i < cubicPoints; i++) {
+		float x = -RANGE + i * 0.1f;
+		splinePoints[i * 3] = x;
+		splinePoints[i * 3 + 1] = x * x * x;
+		splinePoints[i * 3 + 2] = 0.0f;
 	}
-	
-	glGenBuffers(1, &splineVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, splineVBO);
-	glBufferData(GL_ARRAY_BUFFER, splinePoints.size() * sizeof(GLfloat), splinePoints.data(), GL_DYNAMIC_DRAW);
-	numberOfPoints = splinePoints.size() / 3;
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-	glEnableVertexAttribArray(0);
+	splineBuffer.commit();
+	numberOfPoints = cubicPoints;
 
 	glGenVertexArrays(1, &pointsVAO);
-	glBindVertexArray(pointsVAO);
-
-	std::vector<float> controlFloats;
-	for(int i = 0; i < controlPoints.size(); i++) {
-		controlFloats.push_back(controlPoints[i].x);
-		controlFloats.push_back(controlPoints[i].y);
-		controlFloats.push_back(0.0f);
-	}
-
-	glGenBuffers(1, &pointsVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, pointsVBO);
-	glBufferData(GL_ARRAY_BUFFER, controlFloats.size() * sizeof(GLfloat), controlFloats.data(), GL_DYNAMIC_DRAW);
-
-	//Configure vertex data so readable by vertex shader
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-	glEnableVertexAttribArray(0);
+	pointsBuffer.create(pointsVAO);
+	generateControlPointVertices();
 
 	glm::vec3 objectColour = glm::vec3(1.0f, 0.5f, 0.31f);
 	glm::vec3 lightColour = glm::vec3(1.0f, 1.0f, 1.0f);
 
 	unsigned int splineShader = 0;
 	Shader("Shaders/VertexSplines.vs", "Shaders/FragmentSplines.fs", splineShader);
+	gpuPath.create();
 	glUseProgram(splineShader);
 
 	Shader("Shaders/VertexTexture.vs", "Shaders/FragmentTexture.fs", textShader);
@@ -417,22 +477,23 @@ int main()
 			//Draw Slope
 			glUseProgram(splineShader);
 			setVec3(splineShader, "colour", glm::vec3(1.0f, 0.0f, 0.0f));
-			glBindVertexArray(slopeVAO);
-			glDrawArrays(GL_LINE_STRIP, 0, 2);
+			slopeBuffer.draw(GL_LINE_STRIP);
 		}
 
 		glUseProgram(splineShader);
 
 		setVec3(splineShader, "colour", glm::vec3(1.0f, 0.0f, 0.0f));
-		glBindVertexArray(pointsVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, pointsVBO);
-		glDrawArrays(GL_POINTS, 0, controlPoints.size() + debugPoints.size());
-
-		setVec3(splineShader, "colour", glm::vec3(1.0f));
-		glBindVertexArray(splineVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, splineVBO);
-		glDrawArrays(GL_LINE_STRIP, 0, numberOfPoints);
-		// glDrawArrays(GL_POINTS, 0, numberOfPoints);
+		pointsBuffer.draw(GL_POINTS);
+
+		if (gpuSplines) {
+			gpuPath.setZoom(dimension / 2, zoomScaleFactor);
+			gpuPath.draw(zoom * pan, glm::vec3(1.0f));
+		}
+		else {
+			setVec3(splineShader, "colour", glm::vec3(1.0f));
+			splineBuffer.draw(GL_LINE_STRIP);
+			// glDrawArrays(GL_POINTS, splineBuffer.first(), numberOfPoints);
+		}
 
 		//Draw Background
 		glActiveTexture(GL_TEXTURE1);
@@ -1,90 +1,77 @@
 #include <splines.h>
+#include <pathLod.h>
+#include <tessellate.h>
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 #include <iostream>
 
-GLuint splineVBO;
 GLuint splineVAO;
-GLuint pointsVBO;
 GLuint pointsVAO;
+StreamBuffer splineBuffer;
+StreamBuffer pointsBuffer;
 
 std::vector<glm::vec2> debugPoints;
 
+//Writes a point as an x, y, z vertex and returns the next one
+static float *writeVertex(float *out, glm::vec2 v) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = 0.0f;
+    return out + 3;
+}
+
 void generateControlPointVertices() {
-    std::vector<float> controlFloats;
+    float *out = pointsBuffer.map(debugPoints.size() + controlPoints.size());
     for (glm::vec2 v : debugPoints) {
-        controlFloats.push_back(v.x);
-        controlFloats.push_back(v.y);
-        controlFloats.push_back(0.0f);
+        out = writeVertex(out, v);
     }
     for (glm::vec2 v : controlPoints) {
-        controlFloats.push_back(v.x);
-        controlFloats.push_back(v.y);
-        controlFloats.push_back(0.0f);
+        out = writeVertex(out, v);
     }
+    pointsBuffer.commit();
+}
 
-    glBindVertexArray(pointsVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, pointsVAO);
-    glBufferData(GL_ARRAY_BUFFER, controlFloats.size() * sizeof(GLfloat), controlFloats.data(), GL_STATIC_DRAW);
+//Adaptive tessellation of a whole path straight into splineBuffer, sized once from the step counts
+static void tessellateAdaptive(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segments) {
+    std::vector<int> steps(segments);
+    int vertices = adaptiveVertexCount(xSegments, ySegments, segments, TESSELLATION_TOLERANCE, steps.data());
+    tessellatePathAdaptive(xSegments, ySegments, segments, steps.data(), splineBuffer.map(vertices));
+    splineBuffer.commit();
+    numberOfPoints = vertices;
 }
 
 void generatePointsCubic() {
-    std::vector<float> splinePoints;
-    for(CubicSplineSegment s : cubicSpline) {
-        for(float x = 0; x < 1; x+=0.01) {
-            splinePoints.push_back((x * s.parameterMultiplier) + s.parameterOffset);
-            float y = x * x * x * s.d;
-            y += x * x * s.c;
-            y += x * s.b;
-            y += s.a;
-            splinePoints.push_back(y);
-            splinePoints.push_back(0.0f);
-        }
+    //x is linear in t, so it goes through the same tessellator as a cubic with no t^2 or t^3 terms
+    std::vector<CubicSplineSegment> xSegments;
+    xSegments.reserve(cubicSpline.size());
+    for(const CubicSplineSegment &s : cubicSpline) {
+        xSegments.push_back(CubicSplineSegment(s.parameterOffset, s.parameterMultiplier, 0, 0));
     }
-
-    glBindVertexArray(splineVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, splineVBO);
-    glBufferData(GL_ARRAY_BUFFER, splinePoints.size() * sizeof(GLfloat), splinePoints.data(), GL_STATIC_DRAW);
-    numberOfPoints = splinePoints.size() / 3;
+    tessellateAdaptive(xSegments.data(), cubicSpline.data(), cubicSpline.size());
 
     generateControlPointVertices();
 }
 
 void generatePointsFreeSpaceCubic() {
-    std::vector<float> splinePoints;
-    for(int i = 0; i < xCubicSpline.size(); i++) {
-        for(float t = 0; t < 1; t+=0.01f) {
-            //X coord
-            float x = t * t * t * xCubicSpline[i].d;
-            x += t * t * xCubicSpline[i].c;
-            x += t * xCubicSpline[i].b;
-            x += xCubicSpline[i].a;
-            splinePoints.push_back(x);
-
-            //Y coord
-            float y = t * t * t * yCubicSpline[i].d;
-            y += t * t * yCubicSpline[i].c;
-            y += t * yCubicSpline[i].b;
-            y += yCubicSpline[i].a;
-            splinePoints.push_back(y);
-
-            splinePoints.push_back(0.0f);
-        }
+    tessellateAdaptive(xCubicSpline.data(), yCubicSpline.data(), xCubicSpline.size());
 
-        //Bad debugging snippet
-        // std::cout << "I: " << i << std::endl;
-        // Eigen::Vector4d xCoeffs(xCubicSpline[i].d, xCubicSpline[i].c, xCubicSpline[i].b, xCubicSpline[i].a);
-        // Eigen::Vector4d yCoeffs(yCubicSpline[i].d, yCubicSpline[i].c, yCubicSpline[i].b, yCubicSpline[i].a);
-        // std::cout << xCoeffs;
-        // std::cout << std::endl;
-        // std::cout << yCoeffs;
-        // std::cout << std::endl;
-    }
+    generateControlPointVertices();
+}
 
-    glBindVertexArray(splineVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, splineVBO);
-    glBufferData(GL_ARRAY_BUFFER, splinePoints.size() * sizeof(GLfloat), splinePoints.data(), GL_STATIC_DRAW);
-    numberOfPoints = splinePoints.size() / 3;
+//Tessellates the path at the current zoom level into the next region of splineBuffer, no copy on the CPU
+void generatePointsLod(PathLod &lod) {
+    int vertices = lod.vertexCount();
+    lod.tessellate(splineBuffer.map(vertices));
+    splineBuffer.commit();
+    numberOfPoints = vertices;
 
     generateControlPointVertices();
 }
+
+void updateSplineVertices(PathLod &lod, VertexRange range) {
+    if(range.count <= 0) {
+        return;
+    }
+    lod.tessellate(range, splineBuffer.mapRange(range.first, range.count));
+    splineBuffer.commit();
+}
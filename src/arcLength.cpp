@@ -0,0 +1,129 @@
+#include "arcLength.h"
+#include <algorithm>
+
+//5 point Gauss-Legendre on [0, 1], exact for polynomials up to degree 9
+static const double gaussNodes[5] = {0.04691007703066800, 0.23076534494715845, 0.5, 0.76923465505284155, 0.95308992296933200};
+static const double gaussWeights[5] = {0.11846344252809454, 0.23931433524968324, 0.28444444444444444, 0.23931433524968324, 0.11846344252809454};
+
+static double speed(const CubicSplineSegment &x, const CubicSplineSegment &y, double t) {
+    double dx = x.b + t * (2 * x.c + 3 * t * x.d);
+    double dy = y.b + t * (2 * y.c + 3 * t * y.d);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+//Length of one segment between t0 and t1
+static double segmentLength(const CubicSplineSegment &x, const CubicSplineSegment &y, double t0, double t1) {
+    double width = t1 - t0;
+    double sum = 0;
+    for(int i = 0; i < 5; i++) {
+        sum += gaussWeights[i] * speed(x, y, t0 + width * gaussNodes[i]);
+    }
+    return sum * width;
+}
+
+void ArcLengthTable::build(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int count, int samplesPerSegment, ThreadPool *pool) {
+    xSpline = xSegments;
+    ySpline = ySegments;
+    segmentCount = count;
+    samples = samplesPerSegment;
+    lengths.assign((size_t)count * samples + 1, 0);
+    buckets.clear();
+    if(count == 0) {
+        return;
+    }
+
+    //Segment local running lengths first, every segment writes only its own slice so they can all run at once
+    auto measure = [&](size_t k) {
+        double step = 1.0 / samples;
+        double length = 0;
+        for(int j = 0; j < samples; j++) {
+            length += segmentLength(xSpline[k], ySpline[k], j * step, (j + 1) * step);
+            lengths[k * samples + j + 1] = length;
+        }
+    };
+    if(pool) {
+        //Blocks of segments keep the per task overhead small next to the quadrature
+        const size_t block = 256;
+        pool->parallelFor((count + block - 1) / block, [&](size_t b) {
+            size_t end = std::min((b + 1) * block, (size_t)count);
+            for(size_t k = b * block; k < end; k++) {
+                measure(k);
+            }
+        });
+    }
+    else {
+        for(int k = 0; k < count; k++) {
+            measure(k);
+        }
+    }
+
+    //Then offset each segment by the length of everything before it
+    double offset = 0;
+    for(int k = 0; k < count; k++) {
+        size_t first = (size_t)k * samples;
+        double segmentTotal = lengths[first + samples];
+        for(int j = 1; j <= samples; j++) {
+            lengths[first + j] += offset;
+        }
+        offset += segmentTotal;
+    }
+
+    //One bucket per table entry, so each query only scans about one entry
+    int bucketCount = lengths.size() - 1;
+    buckets.resize(bucketCount + 1);
+    bucketScale = totalLength() > 0 ? bucketCount / totalLength() : 0;
+    int entry = 0;
+    for(int b = 0; b <= bucketCount; b++) {
+        float start = bucketScale > 0 ? b / bucketScale : 0;
+        while(entry + 1 < bucketCount && lengths[entry + 1] <= start) {
+            entry++;
+        }
+        buckets[b] = entry;
+    }
+}
+
+PathLocation ArcLengthTable::locate(float distance, int newtonSteps) const noexcept {
+    PathLocation location;
+    if(segmentCount == 0) {
+        return location;
+    }
+    distance = std::min(std::max(distance, 0.0f), totalLength());
+
+    //Bucket lookup, then step forward to the entry containing distance
+    int last = lengths.size() - 1;
+    int entry = buckets[std::min((int)(distance * bucketScale), last)];
+    while(entry + 1 < last && lengths[entry + 1] <= distance) {
+        entry++;
+    }
+
+    location.segment = entry / samples;
+    int step = entry % samples;
+    float stepLength = lengths[entry + 1] - lengths[entry];
+    float fraction = stepLength > 0 ? (distance - lengths[entry]) / stepLength : 0;
+    double t0 = (double)step / samples;
+    double t = t0 + std::min(fraction, 1.0f) / samples;
+
+    //Newton on length(t0, t) - remaining, the derivative of the length is the speed
+    const CubicSplineSegment &x = xSpline[location.segment];
+    const CubicSplineSegment &y = ySpline[location.segment];
+    double remaining = distance - lengths[entry];
+    for(int i = 0; i < newtonSteps; i++) {
+        double v = speed(x, y, t);
+        if(v <= 0) {
+            break;
+        }
+        t -= (segmentLength(x, y, t0, t) - remaining) / v;
+        t = std::min(std::max(t, t0), t0 + 1.0 / samples);
+    }
+
+    location.t = t;
+    return location;
+}
+
+glm::vec2 ArcLengthTable::positionAt(float distance, int newtonSteps) const noexcept {
+    if(segmentCount == 0) {
+        return glm::vec2(0.0f);
+    }
+    PathLocation location = locate(distance, newtonSteps);
+    return glm::vec2(xSpline[location.segment].evaluate(location.t), ySpline[location.segment].evaluate(location.t));
+}
@@ -0,0 +1,132 @@
+#include "bandedSolvers.h"
+
+using namespace Eigen;
+
+template <typename Scalar>
+using VectorRef = Ref<Matrix<Scalar, Dynamic, 1>>;
+template <typename Scalar>
+using ConstVectorRef = const Ref<const Matrix<Scalar, Dynamic, 1>> &;
+
+template <typename Scalar>
+static void thomas(ConstVectorRef<Scalar> lower, VectorRef<Scalar> diag, ConstVectorRef<Scalar> upper, VectorRef<Scalar> rhs) {
+    int n = rhs.size();
+    if(n == 0) {
+        return;
+    }
+
+    //Forward sweep: eliminate the sub-diagonal
+    for(int i = 1; i < n; i++) {
+        Scalar w = lower(i) / diag(i - 1);
+        diag(i) -= w * upper(i - 1);
+        rhs(i) -= w * rhs(i - 1);
+    }
+
+    //Back substitution
+    rhs(n - 1) /= diag(n - 1);
+    for(int i = n - 2; i >= 0; i--) {
+        rhs(i) = (rhs(i) - upper(i) * rhs(i + 1)) / diag(i);
+    }
+}
+
+template <typename Scalar>
+static void cyclicThomas(ConstVectorRef<Scalar> lower, ConstVectorRef<Scalar> diag, ConstVectorRef<Scalar> upper, VectorRef<Scalar> rhs) {
+    typedef Matrix<Scalar, Dynamic, 1> Vector;
+    int n = rhs.size();
+    if(n == 1) {
+        rhs(0) /= diag(0) + lower(0) + upper(0);
+        return;
+    }
+    if(n == 2) {
+        //Both neighbours of each row are the same unknown, so the corners fold into the off-diagonals
+        Scalar a = diag(0), b = upper(0) + lower(0);
+        Scalar c = lower(1) + upper(1), d = diag(1);
+        Scalar det = a * d - b * c;
+        Scalar x0 = (d * rhs(0) - b * rhs(1)) / det;
+        Scalar x1 = (a * rhs(1) - c * rhs(0)) / det;
+        rhs(0) = x0;
+        rhs(1) = x1;
+        return;
+    }
+
+    //Write A = T + uv^T where T is tridiagonal, u = (gamma, 0, ..., 0, alpha) and v = (1, 0, ..., 0, beta / gamma)
+    //Solving T against both rhs and u then gives x = y - (v.y / (1 + v.z)) z
+    Scalar alpha = upper(n - 1);
+    Scalar beta = lower(0);
+    Scalar gamma = -diag(0);
+
+    Vector tDiag = diag;
+    tDiag(0) -= gamma;
+    tDiag(n - 1) -= alpha * beta / gamma;
+    Vector zDiag = tDiag;
+
+    Vector z = Vector::Zero(n);
+    z(0) = gamma;
+    z(n - 1) = alpha;
+
+    thomas<Scalar>(lower, tDiag, upper, rhs);
+    thomas<Scalar>(lower, zDiag, upper, z);
+
+    Scalar factor = (rhs(0) + beta * rhs(n - 1) / gamma) / (1 + z(0) + beta * z(n - 1) / gamma);
+    rhs -= factor * z;
+}
+
+void solveTridiagonal(const Ref<const VectorXd> &lower, Ref<VectorXd> diag, const Ref<const VectorXd> &upper, Ref<VectorXd> rhs) {
+    thomas<double>(lower, diag, upper, rhs);
+}
+
+void solveTridiagonal(const Ref<const VectorXf> &lower, Ref<VectorXf> diag, const Ref<const VectorXf> &upper, Ref<VectorXf> rhs) {
+    thomas<float>(lower, diag, upper, rhs);
+}
+
+void solveCyclicTridiagonal(const Ref<const VectorXd> &lower, const Ref<const VectorXd> &diag, const Ref<const VectorXd> &upper, Ref<VectorXd> rhs) {
+    cyclicThomas<double>(lower, diag, upper, rhs);
+}
+
+void solveCyclicTridiagonal(const Ref<const VectorXf> &lower, const Ref<const VectorXf> &diag, const Ref<const VectorXf> &upper, Ref<VectorXf> rhs) {
+    cyclicThomas<float>(lower, diag, upper, rhs);
+}
+
+//Row by row Cholesky style elimination, A(i + 1, i) = L(i + 1, i)D(i) + L(i + 1, i - 1)D(i - 1)L(i, i - 1)
+void factorPentadiagonal(Ref<VectorXd> diag, Ref<VectorXd> first, Ref<VectorXd> second) {
+    int n = diag.size();
+    for(int i = 0; i < n; i++) {
+        if(i >= 1) {
+            diag(i) -= first(i - 1) * first(i - 1) * diag(i - 1);
+        }
+        if(i >= 2) {
+            diag(i) -= second(i - 2) * second(i - 2) * diag(i - 2);
+        }
+        if(i + 1 < n) {
+            if(i >= 1) {
+                first(i) -= second(i - 1) * diag(i - 1) * first(i - 1);
+            }
+            first(i) /= diag(i);
+        }
+        if(i + 2 < n) {
+            second(i) /= diag(i);
+        }
+    }
+}
+
+void solveFactoredPentadiagonal(const Ref<const VectorXd> &diag, const Ref<const VectorXd> &first, const Ref<const VectorXd> &second, Ref<VectorXd> rhs) {
+    int n = rhs.size();
+
+    //L z = rhs
+    for(int i = 1; i < n; i++) {
+        rhs(i) -= first(i - 1) * rhs(i - 1);
+        if(i >= 2) {
+            rhs(i) -= second(i - 2) * rhs(i - 2);
+        }
+    }
+
+    //D L^T x = z
+    for(int i = n - 1; i >= 0; i--) {
+        rhs(i) /= diag(i);
+        if(i + 1 < n) {
+            rhs(i) -= first(i) * rhs(i + 1);
+        }
+        if(i + 2 < n) {
+            rhs(i) -= second(i) * rhs(i + 2);
+        }
+    }
+}
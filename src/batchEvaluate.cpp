@@ -0,0 +1,146 @@
+#include "batchEvaluate.h"
+#include "cpuDispatch.h"
+#include <algorithm>
+#if SPLINES_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+PackedSegment packSegment(const CubicSplineSegment &x, const CubicSplineSegment &y) {
+    return {x.a, x.b, x.c, x.d, y.a, y.b, y.c, y.d};
+}
+
+void packSegments(const CubicSplineSegment *x, const CubicSplineSegment *y, int count, PackedSegment *out) {
+    for(int i = 0; i < count; i++) {
+        out[i] = packSegment(x[i], y[i]);
+    }
+}
+
+//Scalar versions, also used for whatever is left after the last whole vector
+static void segmentScalar(const PackedSegment &s, const float *t, int begin, int count, float *x, float *y) {
+    for(int i = begin; i < count; i++) {
+        float u = t[i];
+        x[i] = s.xa + u * (s.xb + u * (s.xc + u * s.xd));
+        y[i] = s.ya + u * (s.yb + u * (s.yc + u * s.yd));
+    }
+}
+
+static void pathScalar(const PackedSegment *segments, int segmentCount, const float *t, int begin, int count, float *x, float *y) {
+    float end = segmentCount;
+    for(int i = begin; i < count; i++) {
+        float u = std::min(std::max(t[i], 0.0f), end);
+        int k = std::min((int)u, segmentCount - 1);
+        u -= k;
+        const PackedSegment &s = segments[k];
+        x[i] = s.xa + u * (s.xb + u * (s.xc + u * s.xd));
+        y[i] = s.ya + u * (s.yb + u * (s.yc + u * s.yd));
+    }
+}
+
+//The vector kernels are written out with intrinsics per instruction set, since the FMAs have to be explicit
+//(strict -std=c++17 doesn't contract a * b + c on its own) and intrinsics can't be inlined across target attributes
+#if SPLINES_SIMD_DISPATCH
+__attribute__((target("avx2,fma"))) static int segmentAvx2(const PackedSegment &s, const float *t, int count, float *x, float *y) {
+    __m256 xa = _mm256_set1_ps(s.xa), xb = _mm256_set1_ps(s.xb), xc = _mm256_set1_ps(s.xc), xd = _mm256_set1_ps(s.xd);
+    __m256 ya = _mm256_set1_ps(s.ya), yb = _mm256_set1_ps(s.yb), yc = _mm256_set1_ps(s.yc), yd = _mm256_set1_ps(s.yd);
+    int i = 0;
+    for(; i + 8 <= count; i += 8) {
+        __m256 u = _mm256_loadu_ps(t + i);
+        _mm256_storeu_ps(x + i, _mm256_fmadd_ps(u, _mm256_fmadd_ps(u, _mm256_fmadd_ps(u, xd, xc), xb), xa));
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(u, _mm256_fmadd_ps(u, _mm256_fmadd_ps(u, yd, yc), yb), ya));
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) static int segmentAvx512(const PackedSegment &s, const float *t, int count, float *x, float *y) {
+    __m512 xa = _mm512_set1_ps(s.xa), xb = _mm512_set1_ps(s.xb), xc = _mm512_set1_ps(s.xc), xd = _mm512_set1_ps(s.xd);
+    __m512 ya = _mm512_set1_ps(s.ya), yb = _mm512_set1_ps(s.yb), yc = _mm512_set1_ps(s.yc), yd = _mm512_set1_ps(s.yd);
+    int i = 0;
+    for(; i + 16 <= count; i += 16) {
+        __m512 u = _mm512_loadu_ps(t + i);
+        _mm512_storeu_ps(x + i, _mm512_fmadd_ps(u, _mm512_fmadd_ps(u, _mm512_fmadd_ps(u, xd, xc), xb), xa));
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(u, _mm512_fmadd_ps(u, _mm512_fmadd_ps(u, yd, yc), yb), ya));
+    }
+    return i;
+}
+
+//Segment k's coefficient j is float 8k + j of the packed array, so every coefficient is one gather with scale 4
+__attribute__((target("avx2,fma"))) static int pathAvx2(const PackedSegment *segments, int segmentCount, const float *t, int count, float *x, float *y) {
+    const float *base = &segments[0].xa;
+    __m256 end = _mm256_set1_ps(segmentCount);
+    __m256i last = _mm256_set1_epi32(segmentCount - 1);
+    int i = 0;
+    for(; i + 8 <= count; i += 8) {
+        __m256 u = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(t + i), _mm256_setzero_ps()), end);
+        __m256i k = _mm256_min_epi32(_mm256_cvttps_epi32(u), last);
+        u = _mm256_sub_ps(u, _mm256_cvtepi32_ps(k));
+        __m256i index = _mm256_slli_epi32(k, 3);
+        __m256 xv = _mm256_fmadd_ps(u, _mm256_i32gather_ps(base + 3, index, 4), _mm256_i32gather_ps(base + 2, index, 4));
+        xv = _mm256_fmadd_ps(u, _mm256_fmadd_ps(u, xv, _mm256_i32gather_ps(base + 1, index, 4)), _mm256_i32gather_ps(base, index, 4));
+        __m256 yv = _mm256_fmadd_ps(u, _mm256_i32gather_ps(base + 7, index, 4), _mm256_i32gather_ps(base + 6, index, 4));
+        yv = _mm256_fmadd_ps(u, _mm256_fmadd_ps(u, yv, _mm256_i32gather_ps(base + 5, index, 4)), _mm256_i32gather_ps(base + 4, index, 4));
+        _mm256_storeu_ps(x + i, xv);
+        _mm256_storeu_ps(y + i, yv);
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) static int pathAvx512(const PackedSegment *segments, int segmentCount, const float *t, int count, float *x, float *y) {
+    const float *base = &segments[0].xa;
+    __m512 end = _mm512_set1_ps(segmentCount);
+    __m512i last = _mm512_set1_epi32(segmentCount - 1);
+    int i = 0;
+    for(; i + 16 <= count; i += 16) {
+        __m512 u = _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(t + i), _mm512_setzero_ps()), end);
+        __m512i k = _mm512_min_epi32(_mm512_cvttps_epi32(u), last);
+        u = _mm512_sub_ps(u, _mm512_cvtepi32_ps(k));
+        __m512i index = _mm512_slli_epi32(k, 3);
+        __m512 xv = _mm512_fmadd_ps(u, _mm512_i32gather_ps(index, base + 3, 4), _mm512_i32gather_ps(index, base + 2, 4));
+        xv = _mm512_fmadd_ps(u, _mm512_fmadd_ps(u, xv, _mm512_i32gather_ps(index, base + 1, 4)), _mm512_i32gather_ps(index, base, 4));
+        __m512 yv = _mm512_fmadd_ps(u, _mm512_i32gather_ps(index, base + 7, 4), _mm512_i32gather_ps(index, base + 6, 4));
+        yv = _mm512_fmadd_ps(u, _mm512_fmadd_ps(u, yv, _mm512_i32gather_ps(index, base + 5, 4)), _mm512_i32gather_ps(index, base + 4, 4));
+        _mm512_storeu_ps(x + i, xv);
+        _mm512_storeu_ps(y + i, yv);
+    }
+    return i;
+}
+#endif
+
+void evaluateSegmentBatch(const PackedSegment &segment, const float *t, int count, float *x, float *y) {
+    int done = 0;
+#if SPLINES_SIMD_DISPATCH
+    switch(detectSimdLevel()) {
+        case SimdLevel::AVX512:
+            done = segmentAvx512(segment, t, count, x, y);
+            break;
+        case SimdLevel::AVX2:
+            done = segmentAvx2(segment, t, count, x, y);
+            break;
+        default:
+            break;
+    }
+#endif
+    segmentScalar(segment, t, done, count, x, y);
+}
+
+void evaluatePathBatch(const PackedSegment *segments, int segmentCount, const float *t, int count, float *x, float *y) {
+    if(segmentCount < 1) {
+        std::fill(x, x + count, 0.0f);
+        std::fill(y, y + count, 0.0f);
+        return;
+    }
+
+    int done = 0;
+#if SPLINES_SIMD_DISPATCH
+    switch(detectSimdLevel()) {
+        case SimdLevel::AVX512:
+            done = pathAvx512(segments, segmentCount, t, count, x, y);
+            break;
+        case SimdLevel::AVX2:
+            done = pathAvx2(segments, segmentCount, t, count, x, y);
+            break;
+        default:
+            break;
+    }
+#endif
+    pathScalar(segments, segmentCount, t, done, count, x, y);
+}
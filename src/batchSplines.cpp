@@ -0,0 +1,25 @@
+#include "batchSplines.h"
+
+void calculateBatch(const std::vector<PathInput> &paths, BatchMode mode, SplineArena &arena, ThreadPool &pool) {
+    //Lay out every path's segments before solving so workers only ever write to their own slice
+    arena.offsets.resize(paths.size() + 1);
+    arena.offsets[0] = 0;
+    for(size_t i = 0; i < paths.size(); i++) {
+        size_t segments = paths[i].count > 1 ? paths[i].count - 1 : 0;
+        arena.offsets[i + 1] = arena.offsets[i] + segments;
+    }
+    arena.xSegments.resize(arena.offsets.back());
+    arena.ySegments.resize(arena.offsets.back());
+
+    pool.parallelFor(paths.size(), [&](size_t i) {
+        const PathInput &path = paths[i];
+        CubicSplineSegment *x = arena.xSegments.data() + arena.offsets[i];
+        CubicSplineSegment *y = arena.ySegments.data() + arena.offsets[i];
+        if(mode == BatchMode::Hermite) {
+            solveFreeSpaceCubicHermite(path.points, path.slopes, path.count, x, y);
+        }
+        else {
+            solveFreeSpaceCubic(path.points, path.count, path.startSlope, path.endSlope, x, y);
+        }
+    });
+}
@@ -0,0 +1,196 @@
+#include "bspline.h"
+#include <algorithm>
+
+BSplinePath::BSplinePath(const std::vector<double> &knots, const std::vector<glm::vec2> &controlPoints, const std::vector<double> &weights)
+    : knots(knots), controlPoints(controlPoints), weights(weights) {
+    int n = controlPoints.size();
+    spanSegment.assign(knots.size(), -1);
+    for(int j = degree; j < n; j++) {
+        if(knots[j] < knots[j + 1]) {
+            spanSegment[j] = spanStarts.size();
+            spanStarts.push_back(j);
+        }
+    }
+
+    //Uniform only if there are no repeated knots inside the domain, so every span is a segment
+    if(!spanStarts.empty() && (int)spanStarts.size() == n - degree) {
+        double step = knots[degree + 1] - knots[degree];
+        bool uniform = true;
+        for(int j = degree; j < n && uniform; j++) {
+            uniform = std::abs((knots[j + 1] - knots[j]) - step) <= 1e-12 * step;
+        }
+        uniformStep = uniform ? step : 0;
+    }
+}
+
+BSplinePath BSplinePath::uniform(const std::vector<glm::vec2> &controlPoints) {
+    int spans = std::max((int)controlPoints.size() - degree, 0);
+    std::vector<double> knots;
+    knots.reserve(controlPoints.size() + degree + 1);
+    for(int i = 0; i < degree; i++) {
+        knots.push_back(0);
+    }
+    for(int i = 0; i <= spans; i++) {
+        knots.push_back(i);
+    }
+    for(int i = 0; i < degree; i++) {
+        knots.push_back(spans);
+    }
+    return BSplinePath(knots, controlPoints);
+}
+
+//Power basis a + bt + ct^2 + dt^3 to Bezier points: a, a + b/3, a + 2b/3 + c/3, a + b + c + d
+BSplinePath BSplinePath::fromSegments(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments) {
+    int n = xSegments.size();
+    std::vector<glm::vec2> controlPoints;
+    std::vector<double> knots;
+    if(n == 0) {
+        return BSplinePath();
+    }
+    controlPoints.reserve(3 * n + 1);
+    knots.reserve(3 * n + 5);
+
+    knots.push_back(0);
+    for(int i = 0; i < n; i++) {
+        const CubicSplineSegment &x = xSegments[i];
+        const CubicSplineSegment &y = ySegments[i];
+        controlPoints.push_back(glm::vec2(x.a, y.a));
+        controlPoints.push_back(glm::vec2(x.a + x.b / 3, y.a + y.b / 3));
+        controlPoints.push_back(glm::vec2(x.a + (2 * x.b + x.c) / 3, y.a + (2 * y.b + y.c) / 3));
+        for(int k = 0; k < 3; k++) {
+            knots.push_back(i);
+        }
+    }
+    const CubicSplineSegment &x = xSegments.back();
+    const CubicSplineSegment &y = ySegments.back();
+    controlPoints.push_back(glm::vec2(x.a + x.b + x.c + x.d, y.a + y.b + y.c + y.d));
+    for(int k = 0; k < 4; k++) {
+        knots.push_back(n);
+    }
+
+    return BSplinePath(knots, controlPoints);
+}
+
+//Span j holds knots[j] <= u < knots[j + 1], clamped to the first and last non-empty span
+int BSplinePath::findSpan(double u) const {
+    if(uniformStep > 0) {
+        int span = (int)std::floor((u - knots[degree]) / uniformStep);
+        return degree + std::min(std::max(span, 0), (int)spanStarts.size() - 1);
+    }
+
+    int n = controlPoints.size();
+    int j = std::upper_bound(knots.begin() + degree, knots.begin() + n + 1, u) - knots.begin() - 1;
+    if(j < spanStarts.front()) {
+        return spanStarts.front();
+    }
+    if(j > spanStarts.back()) {
+        return spanStarts.back();
+    }
+    return j;
+}
+
+//Rational paths run in homogeneous coordinates (wx, wy, w) and divide at the end
+//The derivative comes out of the second to last level of the triangle: p(d[p] - d[p - 1]) / (knots[j + 1] - knots[j])
+void BSplinePath::deBoor(int j, double u, glm::dvec2 &value, glm::dvec2 &derivative) const {
+    glm::dvec3 d[degree + 1];
+    for(int i = 0; i <= degree; i++) {
+        int index = j - degree + i;
+        double w = weights.empty() ? 1 : weights[index];
+        d[i] = glm::dvec3(controlPoints[index].x * w, controlPoints[index].y * w, w);
+    }
+
+    glm::dvec3 slope;
+    for(int r = 1; r <= degree; r++) {
+        if(r == degree) {
+            slope = (d[degree] - d[degree - 1]) * (degree / (knots[j + 1] - knots[j]));
+        }
+        for(int i = degree; i >= r; i--) {
+            double left = knots[j - degree + i];
+            double alpha = (u - left) / (knots[j + 1 + i - r] - left);
+            d[i] = (1 - alpha) * d[i - 1] + alpha * d[i];
+        }
+    }
+
+    //Quotient rule, with w = 1 everywhere this is just the plain value and slope
+    value = glm::dvec2(d[degree].x, d[degree].y) / d[degree].z;
+    derivative = (glm::dvec2(slope.x, slope.y) - value * slope.z) / d[degree].z;
+}
+
+glm::vec2 BSplinePath::evaluate(double u) const {
+    if(spanStarts.empty()) {
+        return glm::vec2(0.0f);
+    }
+    u = std::min(std::max(u, domainStart()), domainEnd());
+    glm::dvec2 value;
+    glm::dvec2 derivative;
+    deBoor(findSpan(u), u, value, derivative);
+    return glm::vec2(value);
+}
+
+void BSplinePath::evaluate(const double *u, int count, glm::vec2 *out) const {
+    if(spanStarts.empty()) {
+        std::fill(out, out + count, glm::vec2(0.0f));
+        return;
+    }
+    double start = domainStart();
+    double end = domainEnd();
+    glm::dvec2 value;
+    glm::dvec2 derivative;
+    for(int i = 0; i < count; i++) {
+        double clamped = std::min(std::max(u[i], start), end);
+        deBoor(findSpan(clamped), clamped, value, derivative);
+        out[i] = glm::vec2(value);
+    }
+}
+
+//A cubic is fixed by its value and slope at both ends, so Hermite reproduces polynomial spans exactly
+void BSplinePath::spanSegments(int k, CubicSplineSegment &x, CubicSplineSegment &y) const {
+    int j = spanStarts[k];
+    double width = knots[j + 1] - knots[j];
+    glm::dvec2 p0, p1, d0, d1;
+    deBoor(j, knots[j], p0, d0);
+    deBoor(j, knots[j + 1], p1, d1);
+    d0 *= width;
+    d1 *= width;
+
+    x = hermiteSegment<float>(p0.x, p1.x, d0.x, d1.x);
+    x.parameterOffset = knots[j];
+    x.outputOffset = p0.x;
+    x.parameterMultiplier = width;
+
+    y = hermiteSegment<float>(p0.y, p1.y, d0.y, d1.y);
+    y.parameterOffset = knots[j];
+    y.outputOffset = p0.y;
+    y.parameterMultiplier = width;
+}
+
+void BSplinePath::toSegments(std::vector<CubicSplineSegment> &xSegments, std::vector<CubicSplineSegment> &ySegments) const {
+    xSegments.resize(spanStarts.size());
+    ySegments.resize(spanStarts.size());
+    for(int k = 0; k < (int)spanStarts.size(); k++) {
+        spanSegments(k, xSegments[k], ySegments[k]);
+    }
+}
+
+SegmentRange BSplinePath::setControlPoint(int i, glm::vec2 point, std::vector<CubicSplineSegment> &xSegments, std::vector<CubicSplineSegment> &ySegments) {
+    controlPoints[i] = point;
+
+    //Control point i supports spans i to i + degree
+    SegmentRange range;
+    range.first = -1;
+    for(int j = std::max(i, (int)degree); j <= i + degree && j < (int)controlPoints.size(); j++) {
+        int k = spanSegment[j];
+        if(k < 0) {
+            continue;
+        }
+        spanSegments(k, xSegments[k], ySegments[k]);
+        if(range.first < 0) {
+            range.first = k;
+        }
+        range.count = k - range.first + 1;
+    }
+    if(range.first < 0) {
+        range.first = 0;
+    }
+    return range;
+}
@@ -0,0 +1,79 @@
+#include "compiledPath.h"
+#include <algorithm>
+
+CompiledPath::CompiledPath(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, int samplesPerSegment)
+    : xSpline(xSegments), ySpline(ySegments) {
+    int n = std::min(xSpline.size(), ySpline.size());
+    coefficients.resize(n);
+    starts.resize(n > 0 ? n + 1 : 0);
+    for(int k = 0; k < n; k++) {
+        const CubicSplineSegment &x = xSpline[k];
+        const CubicSplineSegment &y = ySpline[k];
+        coefficients[k] = {x.a, x.b, x.c, x.d, y.a, y.b, y.c, y.d};
+        starts[k] = x.parameterOffset;
+        starts[k + 1] = x.parameterOffset + x.parameterMultiplier;
+    }
+
+    //Uniform when every segment starts where it would with the first segment's width
+    if(n > 0 && xSpline[0].parameterMultiplier > 0) {
+        float width = xSpline[0].parameterMultiplier;
+        bool uniform = true;
+        for(int k = 1; k <= n && uniform; k++) {
+            uniform = std::abs(starts[k] - (starts[0] + k * width)) <= 1e-5f * width * (k + 1);
+        }
+        uniformWidth = uniform ? width : 0;
+    }
+
+    arcLength.build(xSpline.data(), ySpline.data(), n, samplesPerSegment);
+}
+
+CompiledPath::CompiledPath(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, const VelocityLimits &limits, float spacing, int samplesPerSegment)
+    : CompiledPath(xSegments, ySegments, samplesPerSegment) {
+    velocityProfile = calculateVelocityProfile(arcLength, limits, spacing);
+}
+
+//Value, first and second derivative by Horner, then heading and curvature from the derivatives
+PathState CompiledPath::evaluateSegment(int segment, float t) const noexcept {
+    const Coefficients &c = coefficients[segment];
+    PathState state;
+    state.position = glm::vec2(c.xa + t * (c.xb + t * (c.xc + t * c.xd)), c.ya + t * (c.yb + t * (c.yc + t * c.yd)));
+    float dx = c.xb + t * (2 * c.xc + 3 * t * c.xd);
+    float dy = c.yb + t * (2 * c.yc + 3 * t * c.yd);
+    float ddx = 2 * c.xc + 6 * t * c.xd;
+    float ddy = 2 * c.yc + 6 * t * c.yd;
+    float speedSquared = dx * dx + dy * dy;
+    state.heading = std::atan2(dy, dx);
+    state.curvature = speedSquared > 0 ? (dx * ddy - dy * ddx) / (speedSquared * std::sqrt(speedSquared)) : 0;
+    return state;
+}
+
+PathState CompiledPath::evaluate(float t) const noexcept {
+    int n = coefficients.size();
+    if(n == 0) {
+        return PathState();
+    }
+    t = std::min(std::max(t, starts.front()), starts.back());
+
+    int segment;
+    if(uniformWidth > 0) {
+        segment = std::min((int)((t - starts.front()) / uniformWidth), n - 1);
+    }
+    else {
+        segment = std::upper_bound(starts.begin() + 1, starts.end() - 1, t) - starts.begin() - 1;
+    }
+    float width = starts[segment + 1] - starts[segment];
+    float local = width > 0 ? std::min(std::max((t - starts[segment]) / width, 0.0f), 1.0f) : 0;
+    return evaluateSegment(segment, local);
+}
+
+PathState CompiledPath::evaluateAtDistance(float distance) const noexcept {
+    if(coefficients.empty()) {
+        return PathState();
+    }
+    PathLocation location = arcLength.locate(distance);
+    return evaluateSegment(location.segment, location.t);
+}
+
+PathState CompiledPath::evaluateAtTime(float s) const noexcept {
+    return evaluateAtDistance(sampleProfile(velocityProfile, s).distance);
+}
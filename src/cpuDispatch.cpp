@@ -0,0 +1,19 @@
+#include "cpuDispatch.h"
+
+static SimdLevel queryCpu() {
+#if SPLINES_SIMD_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = queryCpu();
+    return level;
+}
@@ -0,0 +1,150 @@
+#include "fixedPointExport.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+//Rounds to the nearest representable value, false if it doesn't fit
+template <typename Int, int FractionBits>
+static bool toFixed(double value, Int &out) {
+    double scaled = std::round(std::ldexp(value, FractionBits));
+    //The max of int64_t isn't a double, so compare against -min which is
+    double limit = -(double)std::numeric_limits<Int>::min();
+    if(!(scaled >= -limit && scaled < limit)) {
+        return false;
+    }
+    out = (Int)scaled;
+    return true;
+}
+
+//Differences of a + bt + ct^2 + dt^3 with step h:
+//first = bh + ch^2 + dh^3, second = 2ch^2 + 6dh^3, third = 6dh^3
+//|a| + |b| + |c| + |d| bounds every sample on 0 to 1, so if that fits stepping can't overflow either
+template <typename Int, int FractionBits>
+static bool differences(const CubicSplineSegment &s, double h, FixedDifferences<Int> &out) {
+    double h2 = h * h;
+    double h3 = h2 * h;
+    double a = s.a, b = s.b, c = s.c, d = s.d;
+    Int bound;
+    return toFixed<Int, FractionBits>(std::abs(a) + std::abs(b) + std::abs(c) + std::abs(d), bound) &&
+           toFixed<Int, FractionBits>(a, out.value) &&
+           toFixed<Int, FractionBits>(b * h + c * h2 + d * h3, out.first) &&
+           toFixed<Int, FractionBits>(2 * c * h2 + 6 * d * h3, out.second) &&
+           toFixed<Int, FractionBits>(6 * d * h3, out.third);
+}
+
+template <typename Int, int FractionBits>
+FixedPointPath<Int, FractionBits> exportFixedPoint(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int count, int steps) {
+    FixedPointPath<Int, FractionBits> path;
+    if(steps < 1 || count < 1) {
+        return path;
+    }
+    path.x.resize(count);
+    path.y.resize(count);
+    double h = 1.0 / steps;
+    for(int k = 0; k < count; k++) {
+        if(!differences<Int, FractionBits>(xSegments[k], h, path.x[k]) || !differences<Int, FractionBits>(ySegments[k], h, path.y[k])) {
+            return FixedPointPath<Int, FractionBits>();
+        }
+    }
+    path.steps = steps;
+    return path;
+}
+
+//Signed overflow is undefined in C++ but wraps on the controller, so the adds go through the unsigned type
+template <typename Int>
+static Int wrappingAdd(Int a, Int b) {
+    typedef typename std::make_unsigned<Int>::type Unsigned;
+    return (Int)(Unsigned)((Unsigned)a + (Unsigned)b);
+}
+
+//Emits steps samples of one table, and one more (the segment end) if last is set
+template <typename Int>
+static void stepTable(FixedDifferences<Int> d, int steps, bool last, Int *out) {
+    for(int i = 0; i < steps; i++) {
+        out[i] = d.value;
+        d.value = wrappingAdd(d.value, d.first);
+        d.first = wrappingAdd(d.first, d.second);
+        d.second = wrappingAdd(d.second, d.third);
+    }
+    if(last) {
+        out[steps] = d.value;
+    }
+}
+
+template <typename Int, int FractionBits>
+void stepFixedPoint(const FixedPointPath<Int, FractionBits> &path, Int *x, Int *y) {
+    int n = path.segmentCount();
+    for(int k = 0; k < n; k++) {
+        size_t first = (size_t)k * path.steps;
+        stepTable(path.x[k], path.steps, k == n - 1, x + first);
+        stepTable(path.y[k], path.steps, k == n - 1, y + first);
+    }
+}
+
+template <typename Int, int FractionBits>
+FixedPointError measureFixedPointError(const FixedPointPath<Int, FractionBits> &path, const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments) {
+    FixedPointError error;
+    int samples = path.sampleCount();
+    if(samples == 0) {
+        return error;
+    }
+    std::vector<Int> x(samples);
+    std::vector<Int> y(samples);
+    stepFixedPoint(path, x.data(), y.data());
+
+    double scale = 1 / path.scale();
+    double sum = 0;
+    for(int i = 0; i < samples; i++) {
+        int k = std::min(i / path.steps, path.segmentCount() - 1);
+        int step = i - k * path.steps;
+        double t = (double)step / path.steps;
+        const CubicSplineSegment &xs = xSegments[k];
+        const CubicSplineSegment &ys = ySegments[k];
+        double dx = x[i] * scale - (xs.a + t * (xs.b + t * ((double)xs.c + t * xs.d)));
+        double dy = y[i] * scale - (ys.a + t * (ys.b + t * ((double)ys.c + t * ys.d)));
+        double distance = std::sqrt(dx * dx + dy * dy);
+        sum += distance * distance;
+        if(distance > error.maxError) {
+            error.maxError = distance;
+            error.worstSegment = k;
+            error.worstStep = step;
+        }
+    }
+    error.rmsError = std::sqrt(sum / samples);
+    return error;
+}
+
+template <typename Int, int FractionBits>
+void writeFixedPointSource(std::ostream &out, const FixedPointPath<Int, FractionBits> &path, const std::string &name) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+    const char *type = sizeof(Int) == 4 ? "int32_t" : "int64_t";
+    const char *suffix = sizeof(Int) == 4 ? "" : "LL";
+
+    out << "#include <stdint.h>\n\n";
+    out << "/* Q" << sizeof(Int) * 8 - FractionBits << "." << FractionBits << " forward differences {value, first, second, third} */\n";
+    out << "#define " << upper << "_STEPS " << path.steps << "\n";
+    out << "#define " << upper << "_SEGMENTS " << path.segmentCount() << "\n\n";
+
+    const std::vector<FixedDifferences<Int>> *tables[2] = {&path.x, &path.y};
+    const char *axes[2] = {"_x", "_y"};
+    for(int axis = 0; axis < 2; axis++) {
+        out << "static const " << type << " " << name << axes[axis] << "[" << std::max(path.segmentCount(), 1) << "][4] = {\n";
+        for(const FixedDifferences<Int> &d : *tables[axis]) {
+            out << "    {" << (long long)d.value << suffix << ", " << (long long)d.first << suffix << ", "
+                << (long long)d.second << suffix << ", " << (long long)d.third << suffix << "},\n";
+        }
+        out << "};\n";
+    }
+}
+
+template FixedPointPathQ16 exportFixedPoint<int32_t, 16>(const CubicSplineSegment *, const CubicSplineSegment *, int, int);
+template FixedPointPathQ32 exportFixedPoint<int64_t, 32>(const CubicSplineSegment *, const CubicSplineSegment *, int, int);
+template void stepFixedPoint<int32_t, 16>(const FixedPointPathQ16 &, int32_t *, int32_t *);
+template void stepFixedPoint<int64_t, 32>(const FixedPointPathQ32 &, int64_t *, int64_t *);
+template FixedPointError measureFixedPointError<int32_t, 16>(const FixedPointPathQ16 &, const CubicSplineSegment *, const CubicSplineSegment *);
+template FixedPointError measureFixedPointError<int64_t, 32>(const FixedPointPathQ32 &, const CubicSplineSegment *, const CubicSplineSegment *);
+template void writeFixedPointSource<int32_t, 16>(std::ostream &, const FixedPointPathQ16 &, const std::string &);
+template void writeFixedPointSource<int64_t, 32>(std::ostream &, const FixedPointPathQ32 &, const std::string &);
@@ -0,0 +1,125 @@
+#include "gpuSplines.h"
+#include "batchEvaluate.h"
+#include <OpenGLHeaders/Shader.h>
+#include <algorithm>
+
+//Texture units the coefficients and segment offsets are bound to, 0 and 1 hold the text and background textures
+static const int coefficientUnit = 2;
+static const int startUnit = 3;
+
+void GpuSplinePath::create(const char *vertexPath, const char *fragmentPath) {
+    Shader(vertexPath, fragmentPath, shader);
+    glUseProgram(shader);
+    setInt(shader, "coefficients", coefficientUnit);
+    setInt(shader, "starts", startUnit);
+
+    glGenBuffers(1, &coefficientBuffer);
+    glGenTextures(1, &coefficientTexture);
+    glGenBuffers(1, &startBuffer);
+    glGenTextures(1, &startTexture);
+    //No vertex attributes, everything comes from gl_VertexID, but core profiles still need a VAO bound to draw
+    glGenVertexArrays(1, &vao);
+}
+
+void GpuSplinePath::destroy() {
+    glDeleteVertexArrays(1, &vao);
+    glDeleteTextures(1, &coefficientTexture);
+    glDeleteBuffers(1, &coefficientBuffer);
+    glDeleteTextures(1, &startTexture);
+    glDeleteBuffers(1, &startBuffer);
+    glDeleteProgram(shader);
+    vao = coefficientTexture = coefficientBuffer = startTexture = startBuffer = 0;
+    shader = 0;
+    segments = 0;
+    secondDerivatives.clear();
+    samples.clear();
+    starts.assign(1, 0);
+}
+
+bool GpuSplinePath::countSamples(int first, int count) {
+    bool changed = false;
+    for(int k = first; k < first + count; k++) {
+        int steps = flatnessSteps(secondDerivatives[k], tolerance);
+        changed |= steps != samples[k];
+        samples[k] = steps;
+    }
+    return changed;
+}
+
+//Offsets move for every segment after a changed count, so they're always uploaded whole
+void GpuSplinePath::uploadStarts() {
+    starts.resize(segments + 1);
+    starts[0] = 0;
+    for(int k = 0; k < segments; k++) {
+        starts[k + 1] = starts[k] + samples[k];
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, startBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, starts.size() * sizeof(int), starts.data(), GL_DYNAMIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, startTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32I, startBuffer);
+}
+
+void GpuSplinePath::upload(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments) {
+    segments = xSegments.size();
+    std::vector<PackedSegment> packed(segments);
+    packSegments(xSegments.data(), ySegments.data(), segments, packed.data());
+    secondDerivatives.resize(segments);
+    samples.resize(segments);
+    for(int k = 0; k < segments; k++) {
+        secondDerivatives[k] = maxSecondDerivative(xSegments[k], ySegments[k]);
+    }
+    countSamples(0, segments);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, coefficientBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, packed.size() * sizeof(PackedSegment), packed.data(), GL_DYNAMIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, coefficientTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, coefficientBuffer);
+    uploadStarts();
+}
+
+void GpuSplinePath::updateSegments(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, int first, int count) {
+    count = std::min(first + count, segments) - first;
+    if(count <= 0) {
+        return;
+    }
+    std::vector<PackedSegment> packed(count);
+    packSegments(xSegments.data() + first, ySegments.data() + first, count, packed.data());
+    for(int k = first; k < first + count; k++) {
+        secondDerivatives[k] = maxSecondDerivative(xSegments[k], ySegments[k]);
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, coefficientBuffer);
+    glBufferSubData(GL_TEXTURE_BUFFER, first * sizeof(PackedSegment), count * sizeof(PackedSegment), packed.data());
+    //Most drags keep the counts, then the offsets on the GPU are still right
+    if(countSamples(first, count)) {
+        uploadStarts();
+    }
+}
+
+void GpuSplinePath::setZoom(float pixelsPerUnit, double zoomScaleFactor, float pixelTolerance) {
+    float zoomed = pixelTolerance / (pixelsPerUnit * zoomScaleFactor);
+    if(zoomed == tolerance) {
+        return;
+    }
+    tolerance = zoomed;
+    if(countSamples(0, segments)) {
+        uploadStarts();
+    }
+}
+
+void GpuSplinePath::draw(const glm::mat4 &model, glm::vec3 colour) {
+    if(segments == 0) {
+        return;
+    }
+    glUseProgram(shader);
+    setMat4(shader, "model", model);
+    setVec3(shader, "colour", colour);
+    setInt(shader, "segments", segments);
+
+    glActiveTexture(GL_TEXTURE0 + coefficientUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, coefficientTexture);
+    glActiveTexture(GL_TEXTURE0 + startUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, startTexture);
+    glBindVertexArray(vao);
+    glDrawArrays(GL_LINE_STRIP, 0, vertexCount());
+}
@@ -0,0 +1,78 @@
+#include "hermitePath.h"
+#include <algorithm>
+
+void HermitePath::append(glm::vec2 point, glm::vec2 slope) {
+    waypoints.push_back(point);
+    waypointSlopes.push_back(slope);
+    if(waypoints.size() < 2) {
+        return;
+    }
+
+    //Only the new segment between the last two waypoints needs solving
+    xSpline.push_back(CubicSplineSegment());
+    ySpline.push_back(CubicSplineSegment());
+    solveSegment(waypoints.size() - 2);
+}
+
+//Segment i runs from waypoint i to waypoint i + 1
+void HermitePath::solveSegment(size_t i) {
+    CubicSplineSegment x = hermiteSegment(waypoints[i].x, waypoints[i + 1].x, waypointSlopes[i].x, waypointSlopes[i + 1].x);
+    x.parameterOffset = i;
+    x.outputOffset = waypoints[i].x;
+    x.parameterMultiplier = 1;
+
+    CubicSplineSegment y = hermiteSegment(waypoints[i].y, waypoints[i + 1].y, waypointSlopes[i].y, waypointSlopes[i + 1].y);
+    y.parameterOffset = i;
+    y.outputOffset = waypoints[i].y;
+    y.parameterMultiplier = 1;
+
+    xSpline[i] = x;
+    ySpline[i] = y;
+}
+
+//Re-solves the (up to) two segments touching waypoint i
+SegmentRange HermitePath::solveAround(size_t i) {
+    if(xSpline.empty()) {
+        return SegmentRange();
+    }
+    size_t first = i > 0 ? i - 1 : 0;
+    size_t last = std::min(i, xSpline.size() - 1);
+    for(size_t j = first; j <= last; j++) {
+        solveSegment(j);
+    }
+
+    SegmentRange range;
+    range.first = first;
+    range.count = last - first + 1;
+    return range;
+}
+
+SegmentRange HermitePath::setPoint(size_t i, glm::vec2 point) {
+    waypoints[i] = point;
+    return solveAround(i);
+}
+
+SegmentRange HermitePath::setSlope(size_t i, glm::vec2 slope) {
+    waypointSlopes[i] = slope;
+    return solveAround(i);
+}
+
+void HermitePath::pop_back() {
+    if(waypoints.empty()) {
+        return;
+    }
+
+    if(!xSpline.empty()) {
+        xSpline.pop_back();
+        ySpline.pop_back();
+    }
+    waypoints.pop_back();
+    waypointSlopes.pop_back();
+}
+
+void HermitePath::clear() {
+    waypoints.clear();
+    waypointSlopes.clear();
+    xSpline.clear();
+    ySpline.clear();
+}
@@ -0,0 +1,259 @@
+#include "pathBundle.h"
+#include <algorithm>
+#include <cstring>
+
+void PathBundle::resize(int waypointCount, int pathCount) {
+    waypoints = waypointCount;
+    paths = pathCount;
+    size_t size = (size_t)waypoints * paths;
+    x.resize(size);
+    y.resize(size);
+    xSlope.resize(size);
+    ySlope.resize(size);
+    xStart.resize(paths);
+    yStart.resize(paths);
+    xEnd.resize(paths);
+    yEnd.resize(paths);
+}
+
+void PathBundle::setPath(int path, const glm::vec2 *points, const glm::vec2 *slopes, glm::vec2 startSlope, glm::vec2 endSlope) {
+    for(int k = 0; k < waypoints; k++) {
+        size_t i = (size_t)k * paths + path;
+        x[i] = points[k].x;
+        y[i] = points[k].y;
+        if(slopes) {
+            xSlope[i] = slopes[k].x;
+            ySlope[i] = slopes[k].y;
+        }
+    }
+
+    if(waypoints > 1) {
+        glm::vec2 start;
+        glm::vec2 end;
+        paramaterizeEndSlopes(points, waypoints, startSlope, endSlope, start, end);
+        xStart[path] = start.x;
+        yStart[path] = start.y;
+        xEnd[path] = end.x;
+        yEnd[path] = end.y;
+    }
+}
+
+void SegmentBundle::resize(int segmentCount, int pathCount) {
+    segments = segmentCount;
+    paths = pathCount;
+    size_t size = (size_t)segments * paths;
+    for(std::vector<double> *v : {&xa, &xb, &xc, &xd, &ya, &yb, &yc, &yd}) {
+        v->resize(size);
+    }
+    xCurvature.resize(size + paths);
+    yCurvature.resize(size + paths);
+}
+
+CubicSplineSegment SegmentBundle::xSegment(int path, int k) const {
+    size_t i = (size_t)k * paths + path;
+    CubicSplineSegment c(xa[i], xb[i], xc[i], xd[i]);
+    c.parameterOffset = k;
+    c.outputOffset = xa[i];
+    c.parameterMultiplier = 1;
+    return c;
+}
+
+CubicSplineSegment SegmentBundle::ySegment(int path, int k) const {
+    size_t i = (size_t)k * paths + path;
+    CubicSplineSegment c(ya[i], yb[i], yc[i], yd[i]);
+    c.parameterOffset = k;
+    c.outputOffset = ya[i];
+    c.parameterMultiplier = 1;
+    return c;
+}
+
+//The kernels below are written once over a lane type V, which is either double (the scalar tail) or a
+//GCC vector of 4/8 doubles. They have to inline into the target specific wrappers to pick up AVX2/AVX-512
+#if SPLINES_SIMD_DISPATCH
+#define KERNEL_INLINE inline __attribute__((always_inline))
+//Vector loads return by value, but everything is inlined so no vector ever crosses a call boundary
+#pragma GCC diagnostic ignored "-Wpsabi"
+#else
+#define KERNEL_INLINE inline
+#endif
+
+template <typename V>
+static KERNEL_INLINE V load(const double *p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <typename V>
+static KERNEL_INLINE void store(double *p, const V &v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+//Closed form Hermite coefficients (see hermiteSegment) for one dimension of one segment across a vector of paths
+template <typename V>
+static KERNEL_INLINE void hermiteLanes(const double *value, const double *slope, size_t i, size_t next, double *a, double *b, double *c, double *d) {
+    V p0 = load<V>(value + i);
+    V p1 = load<V>(value + next);
+    V m0 = load<V>(slope + i);
+    V m1 = load<V>(slope + next);
+    V dp = p1 - p0;
+    store<V>(a + i, p0);
+    store<V>(b + i, m0);
+    store<V>(c + i, 3 * dp - 2 * m0 - m1);
+    store<V>(d + i, m0 + m1 - 2 * dp);
+}
+
+//Runs paths from begin in whole vectors, returns the first path left over
+template <typename V>
+static KERNEL_INLINE int hermiteKernel(const PathBundle &in, SegmentBundle &out, int begin) {
+    const int lanes = sizeof(V) / sizeof(double);
+    const size_t paths = in.paths;
+    int end = begin + (in.paths - begin) / lanes * lanes;
+    for(int k = 0; k < out.segments; k++) {
+        for(int p = begin; p < end; p += lanes) {
+            size_t i = k * paths + p;
+            hermiteLanes<V>(in.x.data(), in.xSlope.data(), i, i + paths, out.xa.data(), out.xb.data(), out.xc.data(), out.xd.data());
+            hermiteLanes<V>(in.y.data(), in.ySlope.data(), i, i + paths, out.ya.data(), out.yb.data(), out.yc.data(), out.yd.data());
+        }
+    }
+    return end;
+}
+
+//Free space stitched solve (see solveStitchedBanded) for one dimension across a vector of paths
+//Every segment is 1 wide, so the matrix and its forward elimination (w, invDiag) are the same for every path
+//and only the right hand side has to go through the sweeps lane by lane
+template <typename V>
+static KERNEL_INLINE void stitchedLanes(const double *value, const double *start, const double *end, const double *w, const double *invDiag, int n, size_t paths, int p,
+                                        double *m, double *a, double *b, double *c, double *d) {
+    //Right hand side with the forward sweep folded in
+    V previous = load<V>(value + p);
+    for(int k = 0; k <= n; k++) {
+        size_t i = k * paths + p;
+        V rhs;
+        if(k == 0) {
+            rhs = 6 * (load<V>(value + i + paths) - load<V>(value + i) - load<V>(start + p));
+        }
+        else if(k == n) {
+            rhs = 6 * (load<V>(end + p) - (load<V>(value + i) - load<V>(value + i - paths)));
+        }
+        else {
+            rhs = 6 * (load<V>(value + i + paths) - 2 * load<V>(value + i) + load<V>(value + i - paths));
+        }
+        if(k > 0) {
+            rhs -= w[k] * previous;
+        }
+        store<V>(m + i, rhs);
+        previous = rhs;
+    }
+
+    //Back substitution, the upper diagonal is all 1s
+    V next = previous * invDiag[n];
+    store<V>(m + n * paths + p, next);
+    for(int k = n - 1; k >= 0; k--) {
+        size_t i = k * paths + p;
+        next = (load<V>(m + i) - next) * invDiag[k];
+        store<V>(m + i, next);
+    }
+
+    for(int k = 0; k < n; k++) {
+        size_t i = k * paths + p;
+        V m0 = load<V>(m + i);
+        V m1 = load<V>(m + i + paths);
+        V y0 = load<V>(value + i);
+        V y1 = load<V>(value + i + paths);
+        store<V>(a + i, y0);
+        store<V>(b + i, (y1 - y0) - (2 * m0 + m1) * (1.0 / 6));
+        store<V>(c + i, m0 * 0.5);
+        store<V>(d + i, (m1 - m0) * (1.0 / 6));
+    }
+}
+
+template <typename V>
+static KERNEL_INLINE int stitchedKernel(const PathBundle &in, SegmentBundle &out, const double *w, const double *invDiag, int begin) {
+    const int lanes = sizeof(V) / sizeof(double);
+    int end = begin + (in.paths - begin) / lanes * lanes;
+    for(int p = begin; p < end; p += lanes) {
+        stitchedLanes<V>(in.x.data(), in.xStart.data(), in.xEnd.data(), w, invDiag, out.segments, in.paths, p,
+                         out.xCurvature.data(), out.xa.data(), out.xb.data(), out.xc.data(), out.xd.data());
+        stitchedLanes<V>(in.y.data(), in.yStart.data(), in.yEnd.data(), w, invDiag, out.segments, in.paths, p,
+                         out.yCurvature.data(), out.ya.data(), out.yb.data(), out.yc.data(), out.yd.data());
+    }
+    return end;
+}
+
+#if SPLINES_SIMD_DISPATCH
+typedef double double4 __attribute__((vector_size(32)));
+typedef double double8 __attribute__((vector_size(64)));
+
+__attribute__((target("avx2,fma"))) static int hermiteAvx2(const PathBundle &in, SegmentBundle &out) {
+    return hermiteKernel<double4>(in, out, 0);
+}
+
+__attribute__((target("avx512f"))) static int hermiteAvx512(const PathBundle &in, SegmentBundle &out) {
+    return hermiteKernel<double8>(in, out, 0);
+}
+
+__attribute__((target("avx2,fma"))) static int stitchedAvx2(const PathBundle &in, SegmentBundle &out, const double *w, const double *invDiag) {
+    return stitchedKernel<double4>(in, out, w, invDiag, 0);
+}
+
+__attribute__((target("avx512f"))) static int stitchedAvx512(const PathBundle &in, SegmentBundle &out, const double *w, const double *invDiag) {
+    return stitchedKernel<double8>(in, out, w, invDiag, 0);
+}
+#endif
+
+void calculateHermiteBundle(const PathBundle &in, SegmentBundle &out, SimdLevel maxLevel) {
+    out.resize(std::max(in.waypoints - 1, 0), in.paths);
+
+    int done = 0;
+#if SPLINES_SIMD_DISPATCH
+    switch(std::min(detectSimdLevel(), maxLevel)) {
+        case SimdLevel::AVX512:
+            done = hermiteAvx512(in, out);
+            break;
+        case SimdLevel::AVX2:
+            done = hermiteAvx2(in, out);
+            break;
+        default:
+            break;
+    }
+#endif
+    hermiteKernel<double>(in, out, done);
+}
+
+void calculateStitchedBundle(const PathBundle &in, SegmentBundle &out, SimdLevel maxLevel) {
+    out.resize(std::max(in.waypoints - 1, 0), in.paths);
+    int n = out.segments;
+    if(n < 1) {
+        return;
+    }
+
+    //Forward elimination of 2 4 4 ... 4 2 on the diagonal with 1s either side, shared by every path
+    thread_local std::vector<double> elimination;
+    elimination.resize(2 * (n + 1));
+    double *w = elimination.data();
+    double *invDiag = elimination.data() + n + 1;
+    double diag = 2;
+    w[0] = 0;
+    invDiag[0] = 1 / diag;
+    for(int k = 1; k <= n; k++) {
+        w[k] = invDiag[k - 1];
+        diag = (k == n ? 2 : 4) - w[k];
+        invDiag[k] = 1 / diag;
+    }
+
+    int done = 0;
+#if SPLINES_SIMD_DISPATCH
+    switch(std::min(detectSimdLevel(), maxLevel)) {
+        case SimdLevel::AVX512:
+            done = stitchedAvx512(in, out, w, invDiag);
+            break;
+        case SimdLevel::AVX2:
+            done = stitchedAvx2(in, out, w, invDiag);
+            break;
+        default:
+            break;
+    }
+#endif
+    stitchedKernel<double>(in, out, w, invDiag, done);
+}
@@ -0,0 +1,108 @@
+#include "pathLod.h"
+#include <algorithm>
+#include <cmath>
+
+PathLod::PathLod(float pixelsPerUnit, float pixelTolerance) : pixelsPerUnit(pixelsPerUnit), pixelTolerance(pixelTolerance) {}
+
+void PathLod::setPath(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments) {
+    xSpline = xSegments;
+    ySpline = ySegments;
+    levels.clear();
+}
+
+int PathLod::levelFor(double zoomScaleFactor) {
+    return (int)std::floor(std::log2(zoomScaleFactor));
+}
+
+//World units per pixel at zoom 2^(level + 1), the closest the level gets
+float PathLod::tolerance(int level) const {
+    return pixelTolerance / (pixelsPerUnit * std::ldexp(1.0f, level + 1));
+}
+
+PathLod::Level &PathLod::build(int level) {
+    Level &l = levels[level];
+    int n = xSpline.size();
+    l.steps.resize(n);
+    l.starts.resize(n);
+    l.vertexCount = adaptiveVertexCount(xSpline.data(), ySpline.data(), n, tolerance(level), l.steps.data());
+    int start = 0;
+    for(int k = 0; k < n; k++) {
+        l.starts[k] = start;
+        start += l.steps[k];
+    }
+    return l;
+}
+
+PathLod::Level &PathLod::currentSteps() {
+    auto cached = levels.find(currentLevel);
+    return cached != levels.end() ? cached->second : build(currentLevel);
+}
+
+void PathLod::tessellate(float *out) {
+    Level &l = currentSteps();
+    tessellatePathAdaptive(xSpline.data(), ySpline.data(), xSpline.size(), l.steps.data(), out);
+}
+
+//range always starts on a segment and covers whole segments, plus the end vertex if it reaches the end of the path
+void PathLod::tessellate(VertexRange range, float *out) {
+    Level &l = currentSteps();
+    int n = xSpline.size();
+    int end = range.first + range.count;
+    if(n == 0 || range.count <= 0) {
+        return;
+    }
+    int k = std::lower_bound(l.starts.begin(), l.starts.end(), range.first) - l.starts.begin();
+    for(; k < n && l.starts[k] < end; k++) {
+        tessellateSegment(xSpline[k], ySpline[k], l.steps[k], out + (size_t)(l.starts[k] - range.first) * 3);
+    }
+    if(end == l.vertexCount) {
+        segmentEndVertex(xSpline.back(), ySpline.back(), out + (size_t)(end - 1 - range.first) * 3);
+    }
+}
+
+bool PathLod::setZoom(double zoomScaleFactor) {
+    int level = levelFor(zoomScaleFactor);
+    if(level == currentLevel) {
+        return false;
+    }
+    currentLevel = level;
+    return true;
+}
+
+VertexRange PathLod::updateSegments(const std::vector<CubicSplineSegment> &xSegments, const std::vector<CubicSplineSegment> &ySegments, int first, int count) {
+    int n = xSegments.size();
+    int last = std::min(first + count, n) - 1;
+    if(first > last) {
+        return VertexRange();
+    }
+    for(int k = first; k <= last; k++) {
+        xSpline[k] = xSegments[k];
+        ySpline[k] = ySegments[k];
+    }
+
+    auto cached = levels.find(currentLevel);
+    bool inPlace = cached != levels.end();
+    for(int k = first; k <= last && inPlace; k++) {
+        inPlace = flatnessSteps(xSpline[k], ySpline[k], tolerance(currentLevel)) == cached->second.steps[k];
+    }
+    if(!inPlace) {
+        levels.clear();
+        return VertexRange{0, build(currentLevel).vertexCount};
+    }
+
+    //Keep only the current level, the others would need the same check and are rebuilt cheaply on demand
+    Level current = std::move(cached->second);
+    levels.clear();
+    Level &l = levels[currentLevel] = std::move(current);
+
+    VertexRange range;
+    range.first = l.starts[first];
+    range.count = 0;
+    for(int k = first; k <= last; k++) {
+        range.count += l.steps[k];
+    }
+    if(last == n - 1) {
+        range.count++;
+    }
+    return range;
+}
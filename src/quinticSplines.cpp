@@ -0,0 +1,102 @@
+#include "quinticSplines.h"
+
+using namespace Eigen;
+
+template <typename Scalar>
+static QuinticSplineSegmentT<Scalar> freeSpaceSegment(int i, Scalar p0, Scalar p1, Scalar v0, Scalar v1, Scalar a0, Scalar a1) {
+    QuinticSplineSegmentT<Scalar> s = quinticHermiteSegment(p0, p1, v0, v1, a0, a1);
+    s.parameterOffset = i;
+    s.outputOffset = p0;
+    s.parameterMultiplier = 1;
+    return s;
+}
+
+template <typename Scalar>
+void solveFreeSpaceQuinticHermite(const Point2<Scalar> *points, const Point2<Scalar> *slopes, const Point2<Scalar> *accelerations, int count, QuinticSplineSegmentT<Scalar> *xOut, QuinticSplineSegmentT<Scalar> *yOut) {
+    for(int i = 0; i < count - 1; i++) {
+        xOut[i] = freeSpaceSegment(i, points[i].x, points[i + 1].x, slopes[i].x, slopes[i + 1].x, accelerations[i].x, accelerations[i + 1].x);
+        yOut[i] = freeSpaceSegment(i, points[i].y, points[i + 1].y, slopes[i].y, slopes[i + 1].y, accelerations[i].y, accelerations[i + 1].y);
+    }
+}
+
+template void solveFreeSpaceQuinticHermite<float>(const glm::vec2 *, const glm::vec2 *, const glm::vec2 *, int, QuinticSplineSegment *, QuinticSplineSegment *);
+template void solveFreeSpaceQuinticHermite<double>(const glm::dvec2 *, const glm::dvec2 *, const glm::dvec2 *, int, QuinticSplineSegmentd *, QuinticSplineSegmentd *);
+
+template <typename Scalar>
+void solveFreeSpaceQuinticSmooth(const Point2<Scalar> *points, const Point2<Scalar> *slopes, int count, Point2<Scalar> startAcceleration, Point2<Scalar> endAcceleration,
+                                 QuinticSplineSegmentT<Scalar> *xOut, QuinticSplineSegmentT<Scalar> *yOut) {
+    if(count < 2) {
+        return;
+    }
+
+    //Row k is the acceleration at waypoint k, x in the first column and y in the second
+    typedef Matrix<Scalar, Dynamic, 2, RowMajor> Columns;
+    int n = count - 1;
+    thread_local std::vector<Scalar> scratch;
+    scratch.resize(3 * (n + 1));
+    Map<Columns> acceleration(scratch.data(), n + 1, 2);
+    Map<Matrix<Scalar, Dynamic, 1>> diag(scratch.data() + 2 * (n + 1), n + 1);
+    auto delta = [&](int k) { return points[k + 1] - points[k]; };
+
+    acceleration(0, 0) = startAcceleration.x;
+    acceleration(0, 1) = startAcceleration.y;
+    acceleration(n, 0) = endAcceleration.x;
+    acceleration(n, 1) = endAcceleration.y;
+
+    //Interior rows 1 to n - 1, the fixed end accelerations move over to the right hand side
+    for(int k = 1; k < n; k++) {
+        Point2<Scalar> rhs = Scalar(60) * (delta(k) - delta(k - 1)) + Scalar(24) * (slopes[k - 1] - slopes[k + 1]);
+        if(k == 1) {
+            rhs += Scalar(3) * startAcceleration;
+        }
+        if(k == n - 1) {
+            rhs += Scalar(3) * endAcceleration;
+        }
+        acceleration(k, 0) = rhs.x;
+        acceleration(k, 1) = rhs.y;
+    }
+
+    //Thomas algorithm with -3 on both off-diagonals and 18 on the diagonal, always strongly diagonally dominant
+    if(n > 1) {
+        diag(1) = 18;
+        for(int k = 2; k < n; k++) {
+            Scalar w = 3 / diag(k - 1);
+            diag(k) = 18 - 3 * w;
+            acceleration.row(k) += w * acceleration.row(k - 1);
+        }
+        acceleration.row(n - 1) /= diag(n - 1);
+        for(int k = n - 2; k >= 1; k--) {
+            acceleration.row(k) = (acceleration.row(k) + 3 * acceleration.row(k + 1)) / diag(k);
+        }
+    }
+
+    for(int i = 0; i < n; i++) {
+        xOut[i] = freeSpaceSegment(i, points[i].x, points[i + 1].x, slopes[i].x, slopes[i + 1].x, acceleration(i, 0), acceleration(i + 1, 0));
+        yOut[i] = freeSpaceSegment(i, points[i].y, points[i + 1].y, slopes[i].y, slopes[i + 1].y, acceleration(i, 1), acceleration(i + 1, 1));
+    }
+}
+
+template void solveFreeSpaceQuinticSmooth<float>(const glm::vec2 *, const glm::vec2 *, int, glm::vec2, glm::vec2, QuinticSplineSegment *, QuinticSplineSegment *);
+template void solveFreeSpaceQuinticSmooth<double>(const glm::dvec2 *, const glm::dvec2 *, int, glm::dvec2, glm::dvec2, QuinticSplineSegmentd *, QuinticSplineSegmentd *);
+
+std::vector<std::vector<QuinticSplineSegment>> calculateFreeSpaceQuinticHermite(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &slopes, const std::vector<glm::vec2> &accelerations) {
+    if(points.size() < 2) {
+        return {std::vector<QuinticSplineSegment>(), std::vector<QuinticSplineSegment>()};
+    }
+
+    std::vector<QuinticSplineSegment> xSpline(points.size() - 1);
+    std::vector<QuinticSplineSegment> ySpline(points.size() - 1);
+    solveFreeSpaceQuinticHermite(points.data(), slopes.data(), accelerations.data(), points.size(), xSpline.data(), ySpline.data());
+    return {xSpline, ySpline};
+}
+
+std::vector<std::vector<QuinticSplineSegment>> calculateFreeSpaceQuinticSmooth(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &slopes, glm::vec2 startAcceleration, glm::vec2 endAcceleration) {
+    if(points.size() < 2) {
+        return {std::vector<QuinticSplineSegment>(), std::vector<QuinticSplineSegment>()};
+    }
+
+    std::vector<QuinticSplineSegment> xSpline(points.size() - 1);
+    std::vector<QuinticSplineSegment> ySpline(points.size() - 1);
+    solveFreeSpaceQuinticSmooth(points.data(), slopes.data(), points.size(), startAcceleration, endAcceleration, xSpline.data(), ySpline.data());
+    return {xSpline, ySpline};
+}
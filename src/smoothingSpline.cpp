@@ -0,0 +1,119 @@
+#include "smoothingSpline.h"
+#include "bandedSolvers.h"
+
+using namespace Eigen;
+
+//Fits every column of values (one per dimension, all on the same knots and weights) in place
+//h(i) is the width of segment i. values comes back as the smoothed value at each knot and curvature as the
+//second derivative there, which is 0 at both ends (natural spline)
+static void fitSmoothing(const VectorXd &h, const std::vector<float> &weights, double lambda, MatrixXd &values, MatrixXd &curvature) {
+    int n = values.rows();
+    int m = n - 2;
+    curvature.setZero(n, values.cols());
+    if(m < 1) {
+        return;
+    }
+
+    VectorXd invH = h.cwiseInverse();
+    auto invWeight = [&](int i) { return weights.empty() ? 1.0 : 1.0 / weights[i]; };
+
+    //R + lambda Q^T W^-1 Q, row k is interior knot j = k + 1
+    //Column j of Q has 1/h(j - 1), -(1/h(j - 1) + 1/h(j)) and 1/h(j) on rows j - 1, j and j + 1
+    VectorXd diag(m);
+    VectorXd first(m);
+    VectorXd second(m);
+    for(int k = 0; k < m; k++) {
+        int j = k + 1;
+        double centre = invH(j - 1) + invH(j);
+        diag(k) = (h(j - 1) + h(j)) / 3 + lambda * (invH(j - 1) * invH(j - 1) * invWeight(j - 1) + centre * centre * invWeight(j) + invH(j) * invH(j) * invWeight(j + 1));
+        if(k + 1 < m) {
+            double nextCentre = invH(j) + invH(j + 1);
+            first(k) = h(j) / 6 - lambda * invH(j) * (centre * invWeight(j) + nextCentre * invWeight(j + 1));
+        }
+        if(k + 2 < m) {
+            second(k) = lambda * invH(j) * invH(j + 1) * invWeight(j + 1);
+        }
+    }
+    factorPentadiagonal(diag, first, second);
+
+    for(int c = 0; c < values.cols(); c++) {
+        auto y = values.col(c);
+        auto interior = curvature.col(c).segment(1, m);
+
+        //Q^T y, the jump in secant slope at each interior knot
+        for(int k = 0; k < m; k++) {
+            int j = k + 1;
+            interior(k) = (y(j + 1) - y(j)) * invH(j) - (y(j) - y(j - 1)) * invH(j - 1);
+        }
+        solveFactoredPentadiagonal(diag, first, second, interior);
+
+        //g = y - lambda W^-1 Q M
+        auto M = curvature.col(c);
+        for(int i = 0; i < n; i++) {
+            double qm = 0;
+            if(i > 0) {
+                qm += (M(i - 1) - M(i)) * invH(i - 1);
+            }
+            if(i < n - 1) {
+                qm += (M(i + 1) - M(i)) * invH(i);
+            }
+            y(i) -= lambda * invWeight(i) * qm;
+        }
+    }
+}
+
+//Same conversion from knot values and second derivatives as the banded stitched solver
+static std::vector<CubicSplineSegment> smoothedSegments(const VectorXd &knots, const VectorXd &h, const Ref<const VectorXd> &g, const Ref<const VectorXd> &M) {
+    int n = g.size() - 1;
+    std::vector<CubicSplineSegment> allSegments(n);
+    for(int i = 0; i < n; i++) {
+        double hh = h(i) * h(i);
+        CubicSplineSegment c(g(i),
+                             (g(i + 1) - g(i)) - hh * (2 * M(i) + M(i + 1)) / 6,
+                             hh * M(i) / 2,
+                             hh * (M(i + 1) - M(i)) / 6);
+        c.parameterOffset = knots(i);
+        c.outputOffset = g(i);
+        c.parameterMultiplier = h(i);
+        allSegments[i] = c;
+    }
+    return allSegments;
+}
+
+std::vector<CubicSplineSegment> calculateCubicSmoothing(const std::vector<glm::vec2> &points, double lambda, const std::vector<float> &weights) {
+    int n = points.size();
+    if(n < 2) {
+        return std::vector<CubicSplineSegment>();
+    }
+
+    VectorXd knots(n);
+    MatrixXd values(n, 1);
+    for(int i = 0; i < n; i++) {
+        knots(i) = points[i].x;
+        values(i, 0) = points[i].y;
+    }
+    VectorXd h = knots.tail(n - 1) - knots.head(n - 1);
+
+    MatrixXd curvature;
+    fitSmoothing(h, weights, lambda, values, curvature);
+    return smoothedSegments(knots, h, values.col(0), curvature.col(0));
+}
+
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicSmoothing(const std::vector<glm::vec2> &points, double lambda, const std::vector<float> &weights) {
+    int n = points.size();
+    if(n < 2) {
+        return {std::vector<CubicSplineSegment>(), std::vector<CubicSplineSegment>()};
+    }
+
+    VectorXd knots = VectorXd::LinSpaced(n, 0, n - 1);
+    VectorXd h = VectorXd::Ones(n - 1);
+    MatrixXd values(n, 2);
+    for(int i = 0; i < n; i++) {
+        values(i, 0) = points[i].x;
+        values(i, 1) = points[i].y;
+    }
+
+    MatrixXd curvature;
+    fitSmoothing(h, weights, lambda, values, curvature);
+    return {smoothedSegments(knots, h, values.col(0), curvature.col(0)), smoothedSegments(knots, h, values.col(1), curvature.col(1))};
+}
@@ -1,5 +1,6 @@
 #include "splines.h"
 #include "Eigen/Core"
+#include "bandedSolvers.h"
 #include <iostream>
 #include <algorithm>
 
@@ -42,7 +43,8 @@ bool xValueSort(glm::vec2 a, glm::vec2 b) {
     return a.x < b.x;
 }
 
-float safeDivision(float numerator, float denominator) {
+template <typename Scalar>
+Scalar safeDivision(Scalar numerator, Scalar denominator) {
     if(denominator == 0) {
         return 0;
     }
@@ -51,47 +53,35 @@ float safeDivision(float numerator, float denominator) {
     }
 }
 
-std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicHermite(std::vector<glm::vec2> points, std::vector<glm::vec2> slopes) {
+//Both dimensions are paramaterized by waypoint index, so the x and y segments come out of the same pass
+template <typename Scalar>
+void solveFreeSpaceCubicHermite(const Point2<Scalar> *points, const Point2<Scalar> *slopes, int count, CubicSplineSegmentT<Scalar> *xOut, CubicSplineSegmentT<Scalar> *yOut) {
+    for(int i = 0; i < count - 1; i++) {
+        CubicSplineSegmentT<Scalar> x = hermiteSegment(points[i].x, points[i + 1].x, slopes[i].x, slopes[i + 1].x);
+        x.parameterOffset = i;
+        x.outputOffset = points[i].x;
+        x.parameterMultiplier = 1;
+        xOut[i] = x;
+
+        CubicSplineSegmentT<Scalar> y = hermiteSegment(points[i].y, points[i + 1].y, slopes[i].y, slopes[i + 1].y);
+        y.parameterOffset = i;
+        y.outputOffset = points[i].y;
+        y.parameterMultiplier = 1;
+        yOut[i] = y;
+    }
+}
+
+template void solveFreeSpaceCubicHermite<float>(const glm::vec2 *, const glm::vec2 *, int, CubicSplineSegment *, CubicSplineSegment *);
+template void solveFreeSpaceCubicHermite<double>(const glm::dvec2 *, const glm::dvec2 *, int, CubicSplineSegmentd *, CubicSplineSegmentd *);
+
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicHermite(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &slopes) {
     if(slopes.size() < 2) {
         return {std::vector<CubicSplineSegment>(), std::vector<CubicSplineSegment>()};
     } 
-    
-    std::vector<glm::vec2> xPoints;
-    std::vector<glm::vec2> yPoints;
-    for (int i = 0; i < slopes.size(); i++) {
-        xPoints.push_back(glm::vec2(i, points[i].x));
-        yPoints.push_back(glm::vec2(i, points[i].y));
-    }
-
-    std::vector<float> xSlopes;
-    std::vector<float> ySlopes;
-    for(int i = 0; i < slopes.size() - 1; i++) {
-        // float xDerivative = abs(safeDivision(1.0f, points[i + 1].x - points[i].x));
-        // float yDerivative = abs(safeDivision(1.0f, points[i + 1].y - points[i].y));
-        // float xDerivative = abs(points[i + 1].x - points[i].x);
-        // float yDerivative = abs(points[i + 1].y - points[i].y);
-        float xDerivative = 1.0f;
-        float yDerivative = 1.0f;
-
-        // Debugging
-        // glm::vec2 slope1 = glm::vec2(slopes[i].x * xDerivative, yDerivative * slopes[i].y);
-        // glm::vec2 slope2 = glm::vec2(slopes[i + 1].x * xDerivative, yDerivative * slopes[i + 1].y);
-        // std::cout << "1 | X: " << slope1.x << " Y: " << slope1.y << std::endl;
-        // std::cout << "2 | X: " << slope2.x << " Y: " << slope2.y << std::endl << std::endl;
-        // debugPoints.push_back(slope1 + points[i]);
-        // debugPoints.push_back(slope2 + points[i + 1]);
-
-        xSlopes.push_back(xDerivative * slopes[i].x);
-        xSlopes.push_back(xDerivative * slopes[i + 1].x);
-        ySlopes.push_back(yDerivative * slopes[i].y);
-        ySlopes.push_back(yDerivative * slopes[i + 1].y);
-    }
-
-    std::vector<CubicSplineSegment> xSpline;
-    std::vector<CubicSplineSegment> ySpline;
 
-    xSpline = calculateCubicHermite(xPoints, xSlopes);
-    ySpline = calculateCubicHermite(yPoints, ySlopes);
+    std::vector<CubicSplineSegment> xSpline(slopes.size() - 1);
+    std::vector<CubicSplineSegment> ySpline(slopes.size() - 1);
+    solveFreeSpaceCubicHermite(points.data(), slopes.data(), slopes.size(), xSpline.data(), ySpline.data());
 
     return {xSpline, ySpline};
 }
@@ -115,50 +105,17 @@ std::vector<CubicSplineSegment> calculateCubicHermite1Dimensional(std::vector<gl
     return ySpline;
 }
 
-std::vector<CubicSplineSegment> calculateCubicHermite(std::vector<glm::vec2> points, std::vector<float> slopes) {
-    Matrix4d mat;
-    Vector4d y;
-
-    for(int a = 0; a < 4; a++) {
-        for(int b = 0; b < 4; b++) {
-            mat(a, b) = 0;
-        }
-    }
-
-    //X is always 0 for first point and 1 for second due to paramaterization
-    //Complies with first point slope: b + 2cx + 3dx^2 = s (x = 0)
-    mat(0, 1) = 1;
-
-    //Pass point through point 0: a + bx + cx^2 + dx^3 = y (x = 0)
-    mat(1, 0) = 1;
-
-    //Pass point through point 1: a + bx + cx^2 + dx^3 = y (x = 1)
-    mat(2, 0) = 1;
-    mat(2, 1) = 1;
-    mat(2, 2) = 1;
-    mat(2, 3) = 1;
-
-    //Complies with second point slope: b + 2cx + 3dx^2 = s (x = 1)
-    mat(3, 1) = 1;
-    mat(3, 2) = 2;
-    mat(3, 3) = 3;
-
-    Matrix4d invMat = mat.inverse();
-
+//X is always 0 for the first point and 1 for the second due to paramaterization, so the 4x4 system
+//(pass through both points, match both slopes) is constant and hermiteSegment is its closed form inverse
+std::vector<CubicSplineSegment> calculateCubicHermite(const std::vector<glm::vec2> &points, const std::vector<float> &slopes) {
     std::vector<CubicSplineSegment> allSegments;
+    if(points.size() < 2) {
+        return allSegments;
+    }
+    allSegments.reserve(points.size() - 1);
 
     for(int i = 0; i < points.size() - 1; i++) {
-        //First slope
-        y(0) = slopes[i * 2];
-        //First point
-        y(1) = points[i].y;
-        //Second point
-        y(2) = points[i + 1].y;
-        //Second slope
-        y(3) = slopes[i * 2 + 1];
-
-        Vector4d coefficients = mat.inverse() * y;
-        CubicSplineSegment c(coefficients);
+        CubicSplineSegment c = hermiteSegment(points[i].y, points[i + 1].y, slopes[i * 2], slopes[i * 2 + 1]);
         c.parameterOffset = points[i].x;
         c.outputOffset = points[i].y;
         c.parameterMultiplier = points[i + 1].x - points[i].x;
@@ -168,58 +125,15 @@ std::vector<CubicSplineSegment> calculateCubicHermite(std::vector<glm::vec2> poi
     return allSegments;
 }
 
-std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubic(std::vector<glm::vec2> points, glm::vec2 startSlope, glm::vec2 endSlope) {
-    std::vector<glm::vec2> xPoints;
-    std::vector<glm::vec2> yPoints;
-    for(int i = 0; i < points.size(); i++) {
-        xPoints.push_back(glm::vec2(i, points[i].x));
-        yPoints.push_back(glm::vec2(i, points[i].y));
-    }
-
-    std::vector<CubicSplineSegment> xSpline;
-    std::vector<CubicSplineSegment> ySpline;
-
-    if(points.size() > 1) {
-        float startXDerivative = abs(safeDivision(1.0f, (points[1].x - points[0].x)));
-        float startYDerivative = abs(safeDivision(1.0f, (points[1].y - points[0].y)));
-        
-        float startXSlope = startXDerivative * startSlope.x;
-        float startYSlope = startYDerivative * startSlope.y;
-
-        int n = points.size() - 1;
-        float endXDerivative = abs(safeDivision(1.0f, (points[n].x - points[n-1].x)));
-        float endYDerivative = abs(safeDivision(1.0f, (points[n].y - points[n-1].y)));
-
-        float endXSlope = endXDerivative * endSlope.x;
-        float endYSlope = endYDerivative * endSlope.y;
-
-        xSpline = calculateCubicStitched(xPoints, startXSlope, endXSlope, false);
-        ySpline = calculateCubicStitched(yPoints, startYSlope, endYSlope, false);
-    }
-    else {
-        xSpline = calculateCubicStitched(xPoints, 1, 1, false);
-        ySpline = calculateCubicStitched(yPoints, 1, 1, false);
-    }
-
-    return {xSpline, ySpline};
-}
-
 // Non-paramaterized, non-localized
-std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> points, float startSlope, float endSlope, bool linear) {
-    if(linear) {
-        std::sort(points.begin(), points.end(), xValueSort); 
-    }
+// Fills the full 4(n-1) x 4(n-1) stitched matrix as triplets, shared by the dense and sparse solvers
+// Zero entries are still emitted so the sparsity pattern only depends on the number of points
+// Only the x values go into the matrix, so dimensions that share them (free space) can share one factorization
+static void assembleStitchedMatrix(const std::vector<glm::vec2> &points, std::vector<Triplet<double>> &entries) {
     int numVar = (points.size()-1)*4;
-    MatrixXd mat(numVar, numVar);
-    VectorXd y(numVar);
+    entries.clear();
+    entries.reserve(numVar * 3);
     int matIndex = 0;
-
-    for(int a = 0; a < numVar; a++) {
-        for(int b = 0; b < numVar; b++) {
-            mat(a, b) = 0;
-        }
-    }
-
     for(int i = 0; i < points.size() - 1; i++) {
         float x0 = 0;
         float x1 = 1;
@@ -236,25 +150,22 @@ std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> po
             // y(matIndex) = startSlope;
 
             //Starting slope paramaterized: b = (x1 - x0)s
-            mat(matIndex, 1) = 1;
-            y(matIndex) = (realX1-realX0) * startSlope;
+            entries.emplace_back(matIndex, 1, 1);
             matIndex++;
         }
 
         //Pass point through point 0: a + bx + cx^2 + dx^3 = y
-        mat(matIndex, matOffset) = 1;
-        mat(matIndex, matOffset + 1) = x0;
-        mat(matIndex, matOffset + 2) = x0 * x0;
-        mat(matIndex, matOffset + 3) = x0 * x0 * x0;
-        y(matIndex) = points[i].y;
+        entries.emplace_back(matIndex, matOffset, 1);
+        entries.emplace_back(matIndex, matOffset + 1, x0);
+        entries.emplace_back(matIndex, matOffset + 2, x0 * x0);
+        entries.emplace_back(matIndex, matOffset + 3, x0 * x0 * x0);
         matIndex++;
 
         //Pass point through point 1: a + bx + cx^2 + dx^3 = y
-        mat(matIndex, matOffset) = 1;
-        mat(matIndex, matOffset + 1) = x1;
-        mat(matIndex, matOffset + 2) = x1 * x1;
-        mat(matIndex, matOffset + 3) = x1 * x1 * x1;
-        y(matIndex) = points[i + 1].y;
+        entries.emplace_back(matIndex, matOffset, 1);
+        entries.emplace_back(matIndex, matOffset + 1, x1);
+        entries.emplace_back(matIndex, matOffset + 2, x1 * x1);
+        entries.emplace_back(matIndex, matOffset + 3, x1 * x1 * x1);
         matIndex++;
 
         //Match slopes and curvature (C1 and C2 continuity)
@@ -272,11 +183,10 @@ std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> po
             // y(matIndex) = 0;
 
             //Match slopes paramaterized: bi + 2ci + 3di - ( (x(i+1) - xi) / (x(i+2) - x(i+1) )b(i+1) = 0
-            mat(matIndex, matOffset + 1) = 1;
-            mat(matIndex, matOffset + 2) = 2;
-            mat(matIndex, matOffset + 3) = 3;
-            mat(matIndex, secondOffset + 1) = -(realX1 - realX0)/(realX2-realX1);
-            y(matIndex) = 0;
+            entries.emplace_back(matIndex, matOffset + 1, 1);
+            entries.emplace_back(matIndex, matOffset + 2, 2);
+            entries.emplace_back(matIndex, matOffset + 3, 3);
+            entries.emplace_back(matIndex, secondOffset + 1, -(realX1 - realX0)/(realX2-realX1));
             matIndex++;
 
             //Match curvature: 2c(i) + 6d(i)x(i+1) − 2c(i+1) − 6d(i+1)x(i+1) = 0
@@ -288,10 +198,9 @@ std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> po
             // y(matIndex) = 0;
 
             //Match curvature paramaterized: 2ci + 6di - 2( (x(i+1) - xi)^2 / (x(i+2) - x(i+1))^2 )c(i+1) = 0
-            mat(matIndex, matOffset + 2) = 2;
-            mat(matIndex, matOffset + 3) = 6;
-            mat(matIndex, secondOffset + 2) = -2 * ( pow(realX1 - realX0, 2) / pow(realX2 - realX1, 2) );
-            y(matIndex) = 0;
+            entries.emplace_back(matIndex, matOffset + 2, 2);
+            entries.emplace_back(matIndex, matOffset + 3, 6);
+            entries.emplace_back(matIndex, secondOffset + 2, -2 * ( pow(realX1 - realX0, 2) / pow(realX2 - realX1, 2) ));
             matIndex++;
         }
         else {
@@ -302,17 +211,35 @@ std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> po
             // y(matIndex) = endSlope;
 
             //End slope paramaterized: b + 2c + 3d = (x1 - x0)s
-            mat(matIndex, matOffset + 1) = 1;
-            mat(matIndex, matOffset + 2) = 2;
-            mat(matIndex, matOffset + 3) = 3;
-            y(matIndex) = (realX1 - realX0) * endSlope;
+            entries.emplace_back(matIndex, matOffset + 1, 1);
+            entries.emplace_back(matIndex, matOffset + 2, 2);
+            entries.emplace_back(matIndex, matOffset + 3, 3);
             matIndex++;
         }
     }
+}
 
+//Right hand side for assembleStitchedMatrix, in the same row order
+static void assembleStitchedRightHandSide(const std::vector<glm::vec2> &points, float startSlope, float endSlope, Ref<VectorXd> y) {
+    int matIndex = 0;
+    y(matIndex++) = (points[1].x - points[0].x) * startSlope;
+    for(int i = 0; i < points.size() - 1; i++) {
+        y(matIndex++) = points[i].y;
+        y(matIndex++) = points[i + 1].y;
+        if(i < points.size() - 2) {
+            y(matIndex++) = 0;
+            y(matIndex++) = 0;
+        }
+        else {
+            y(matIndex++) = (points[i + 1].x - points[i].x) * endSlope;
+        }
+    }
+}
+
+//Splits the solved coefficient vector back into one segment per pair of points
+static std::vector<CubicSplineSegment> stitchedSegments(const std::vector<glm::vec2> &points, const Ref<const VectorXd> &coefficients) {
     std::vector<CubicSplineSegment> allSegments;
 
-    VectorXd coefficients = mat.inverse() * y;
     for(int i = 0; i < points.size() - 1; i++) {
         Vector4d v = coefficients(seq(i*4, (i*4)+3));
         CubicSplineSegment c(v);
@@ -323,4 +250,380 @@ std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> po
     }
 
     return allSegments;
-}
\ No newline at end of file
+}
+
+static MatrixXd denseStitchedMatrix(const std::vector<glm::vec2> &points) {
+    std::vector<Triplet<double>> entries;
+    assembleStitchedMatrix(points, entries);
+
+    int numVar = (points.size() - 1) * 4;
+    MatrixXd mat = MatrixXd::Zero(numVar, numVar);
+    for(const Triplet<double> &t : entries) {
+        mat(t.row(), t.col()) = t.value();
+    }
+    return mat;
+}
+
+// Reference solver, builds and inverts the full system
+static std::vector<CubicSplineSegment> calculateCubicStitchedDense(const std::vector<glm::vec2> &points, float startSlope, float endSlope) {
+    MatrixXd mat = denseStitchedMatrix(points);
+    VectorXd y(mat.rows());
+    assembleStitchedRightHandSide(points, startSlope, endSlope, y);
+
+    VectorXd coefficients = mat.inverse() * y;
+    return stitchedSegments(points, coefficients);
+}
+
+//Free space x and y points share their paramaterized x values, so one inverse serves both columns
+static std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicDense(const std::vector<glm::vec2> &xPoints, const std::vector<glm::vec2> &yPoints, glm::vec2 start, glm::vec2 end) {
+    MatrixXd mat = denseStitchedMatrix(xPoints);
+    MatrixXd y(mat.rows(), 2);
+    assembleStitchedRightHandSide(xPoints, start.x, end.x, y.col(0));
+    assembleStitchedRightHandSide(yPoints, start.y, end.y, y.col(1));
+
+    MatrixXd coefficients = mat.inverse() * y;
+    return {stitchedSegments(xPoints, coefficients.col(0)), stitchedSegments(yPoints, coefficients.col(1))};
+}
+
+void SparseStitchedSolver::factorize(const std::vector<glm::vec2> &points) {
+    assembleStitchedMatrix(points, entries);
+    int numVar = (points.size() - 1) * 4;
+    mat.resize(numVar, numVar);
+    mat.setFromTriplets(entries.begin(), entries.end());
+
+    //The pattern only changes with the number of points, so moving points only pays for the numeric factorization
+    if(numVar != analyzedSize) {
+        lu.analyzePattern(mat);
+        analyzedSize = numVar;
+    }
+    lu.factorize(mat);
+}
+
+std::vector<CubicSplineSegment> SparseStitchedSolver::solve(const std::vector<glm::vec2> &points, float startSlope, float endSlope) {
+    if(points.size() < 2) {
+        return std::vector<CubicSplineSegment>();
+    }
+
+    factorize(points);
+    y.resize(mat.rows(), 1);
+    assembleStitchedRightHandSide(points, startSlope, endSlope, y.col(0));
+
+    VectorXd coefficients = lu.solve(y);
+    return stitchedSegments(points, coefficients);
+}
+
+std::vector<std::vector<CubicSplineSegment>> SparseStitchedSolver::solveFreeSpace(const std::vector<glm::vec2> &xPoints, const std::vector<glm::vec2> &yPoints, glm::vec2 start, glm::vec2 end) {
+    if(xPoints.size() < 2) {
+        return {std::vector<CubicSplineSegment>(), std::vector<CubicSplineSegment>()};
+    }
+
+    factorize(xPoints);
+    y.resize(mat.rows(), 2);
+    assembleStitchedRightHandSide(xPoints, start.x, end.x, y.col(0));
+    assembleStitchedRightHandSide(yPoints, start.y, end.y, y.col(1));
+
+    MatrixXd coefficients = lu.solve(y);
+    return {stitchedSegments(xPoints, coefficients.col(0)), stitchedSegments(yPoints, coefficients.col(1))};
+}
+
+//One cached sparse solver per thread, so repeated solves of same sized paths share its symbolic analysis
+static SparseStitchedSolver &threadSparseSolver() {
+    thread_local SparseStitchedSolver sparseSolver;
+    return sparseSolver;
+}
+
+//Same conditions as the dense solver, rewritten in terms of the second derivative M(i) at each waypoint
+//Slopes and curvature then match by construction and only one equation per waypoint is left:
+//h(i-1)M(i-1) + 2(h(i-1) + h(i))M(i) + h(i)M(i+1) = 6(s(i) - s(i-1)), h = segment width, s = secant slope
+//The ends replace the missing neighbour with the clamped start/end slope
+//xAt(i) and yAt(i) give waypoint i, so the same code serves both real and paramaterized x values
+//Works in per-thread scratch space, so it is reentrant and stops allocating once the scratch has grown
+//Everything runs in the output Scalar, float segments never touch double and double segments never narrow
+template <typename Scalar, typename XAt, typename YAt>
+static void solveStitchedBanded(int count, XAt xAt, YAt yAt, Scalar startSlope, Scalar endSlope, CubicSplineSegmentT<Scalar> *out) {
+    typedef Map<Matrix<Scalar, Dynamic, 1>> Vector;
+    int n = count - 1;
+    thread_local std::vector<Scalar> scratch;
+    scratch.resize(6 * (n + 1));
+    Vector h(scratch.data(), n);
+    Vector secant(scratch.data() + (n + 1), n);
+    Vector lower(scratch.data() + 2 * (n + 1), n + 1);
+    Vector diag(scratch.data() + 3 * (n + 1), n + 1);
+    Vector upper(scratch.data() + 4 * (n + 1), n + 1);
+    Vector m(scratch.data() + 5 * (n + 1), n + 1);
+
+    for(int i = 0; i < n; i++) {
+        h(i) = (Scalar)xAt(i + 1) - xAt(i);
+        secant(i) = ((Scalar)yAt(i + 1) - yAt(i)) / h(i);
+    }
+
+    //Starting slope: f'(x0) = s
+    lower(0) = 0;
+    diag(0) = 2 * h(0);
+    upper(0) = h(0);
+    m(0) = 6 * (secant(0) - startSlope);
+
+    //Match slopes at interior points (curvature is shared through M)
+    for(int i = 1; i < n; i++) {
+        lower(i) = h(i - 1);
+        diag(i) = 2 * (h(i - 1) + h(i));
+        upper(i) = h(i);
+        m(i) = 6 * (secant(i) - secant(i - 1));
+    }
+
+    //End slope: f'(xn) = s
+    lower(n) = h(n - 1);
+    diag(n) = 2 * h(n - 1);
+    upper(n) = 0;
+    m(n) = 6 * (endSlope - secant(n - 1));
+
+    solveTridiagonal(lower, diag, upper, m);
+
+    //Convert back to the paramaterized form used everywhere else (t = 0 to 1 across each segment)
+    for(int i = 0; i < n; i++) {
+        Scalar hh = h(i) * h(i);
+        CubicSplineSegmentT<Scalar> c(yAt(i),
+                                      h(i) * secant(i) - hh * (2 * m(i) + m(i + 1)) / 6,
+                                      hh * m(i) / 2,
+                                      hh * (m(i + 1) - m(i)) / 6);
+        c.parameterOffset = xAt(i);
+        c.outputOffset = yAt(i);
+        c.parameterMultiplier = h(i);
+        out[i] = c;
+    }
+}
+
+//Solves in Scalar and narrows the result to float segments if that isn't float already
+template <typename Scalar>
+static std::vector<CubicSplineSegment> calculateCubicStitchedBanded(const std::vector<glm::vec2> &points, float startSlope, float endSlope) {
+    std::vector<CubicSplineSegmentT<Scalar>> solved(points.size() - 1);
+    solveStitchedBanded<Scalar>(points.size(), [&](int i) { return (Scalar)points[i].x; }, [&](int i) { return (Scalar)points[i].y; }, startSlope, endSlope, solved.data());
+    return std::vector<CubicSplineSegment>(solved.begin(), solved.end());
+}
+
+std::vector<CubicSplineSegment> calculateCubicStitched(std::vector<glm::vec2> points, float startSlope, float endSlope, bool linear, StitchedSolver solver) {
+    if(linear) {
+        std::sort(points.begin(), points.end(), xValueSort); 
+    }
+    if(points.size() < 2) {
+        return std::vector<CubicSplineSegment>();
+    }
+
+    if(solver == StitchedSolver::Dense) {
+        return calculateCubicStitchedDense(points, startSlope, endSlope);
+    }
+    if(solver == StitchedSolver::Sparse) {
+        return threadSparseSolver().solve(points, startSlope, endSlope);
+    }
+    if(solver == StitchedSolver::BandedFloat) {
+        return calculateCubicStitchedBanded<float>(points, startSlope, endSlope);
+    }
+    return calculateCubicStitchedBanded<double>(points, startSlope, endSlope);
+}
+
+//Converts a start/end slope into the per-waypoint paramaterization used by the free space stitched solvers
+//from and to are the coordinates of the two waypoints at that end of the path
+template <typename Scalar>
+static Scalar paramaterizeEndSlope(Scalar from, Scalar to, Scalar slope) {
+    return std::abs(safeDivision<Scalar>(1, to - from)) * slope;
+}
+
+template <typename Scalar>
+void paramaterizeEndSlopes(const Point2<Scalar> *points, int count, Point2<Scalar> startSlope, Point2<Scalar> endSlope, Point2<Scalar> &start, Point2<Scalar> &end) {
+    start.x = paramaterizeEndSlope(points[0].x, points[1].x, startSlope.x);
+    start.y = paramaterizeEndSlope(points[0].y, points[1].y, startSlope.y);
+
+    int n = count - 1;
+    end.x = paramaterizeEndSlope(points[n - 1].x, points[n].x, endSlope.x);
+    end.y = paramaterizeEndSlope(points[n - 1].y, points[n].y, endSlope.y);
+}
+
+template void paramaterizeEndSlopes<float>(const glm::vec2 *, int, glm::vec2, glm::vec2, glm::vec2 &, glm::vec2 &);
+template void paramaterizeEndSlopes<double>(const glm::dvec2 *, int, glm::dvec2, glm::dvec2, glm::dvec2 &, glm::dvec2 &);
+
+//Free space version of solveStitchedBanded: every segment is 1 wide, so the matrix (2 4 4 ... 4 2 on the diagonal,
+//1s either side) is the same for every dimension. It is eliminated once and each dimension is one more column
+//of the right hand side going through the sweeps
+template <int Dims, typename Scalar>
+void solveFreeSpaceCubicN(const Scalar *points, int count, const Scalar *startSlope, const Scalar *endSlope, CubicSplineSegmentT<Scalar> *const *out) {
+    if(count < 2) {
+        return;
+    }
+
+    //Eigen doesn't allow row major column vectors
+    typedef Matrix<Scalar, Dynamic, Dims, Dims == 1 ? ColMajor : RowMajor> Columns;
+    int n = count - 1;
+    thread_local std::vector<Scalar> scratch;
+    scratch.resize((Dims + 2) * (n + 1));
+    Map<Matrix<Scalar, Dynamic, 1>> w(scratch.data(), n + 1);
+    Map<Matrix<Scalar, Dynamic, 1>> invDiag(scratch.data() + (n + 1), n + 1);
+    Map<Columns> m(scratch.data() + 2 * (n + 1), n + 1, Dims);
+    auto at = [&](int k, int d) { return points[k * Dims + d]; };
+
+    //Forward elimination of the shared matrix
+    Scalar diag = 2;
+    w(0) = 0;
+    invDiag(0) = 1 / diag;
+    for(int k = 1; k <= n; k++) {
+        w(k) = invDiag(k - 1);
+        diag = (k == n ? 2 : 4) - w(k);
+        invDiag(k) = 1 / diag;
+    }
+
+    for(int d = 0; d < Dims; d++) {
+        Scalar start = paramaterizeEndSlope(at(0, d), at(1, d), startSlope[d]);
+        Scalar end = paramaterizeEndSlope(at(n - 1, d), at(n, d), endSlope[d]);
+        m(0, d) = 6 * (at(1, d) - at(0, d) - start);
+        for(int k = 1; k < n; k++) {
+            m(k, d) = 6 * (at(k + 1, d) - 2 * at(k, d) + at(k - 1, d));
+        }
+        m(n, d) = 6 * (end - (at(n, d) - at(n - 1, d)));
+    }
+
+    //Forward sweep and back substitution on every column at once, the upper diagonal is all 1s
+    for(int k = 1; k <= n; k++) {
+        m.row(k) -= w(k) * m.row(k - 1);
+    }
+    m.row(n) *= invDiag(n);
+    for(int k = n - 1; k >= 0; k--) {
+        m.row(k) = (m.row(k) - m.row(k + 1)) * invDiag(k);
+    }
+
+    for(int d = 0; d < Dims; d++) {
+        for(int i = 0; i < n; i++) {
+            Scalar y0 = at(i, d);
+            Scalar y1 = at(i + 1, d);
+            Scalar m0 = m(i, d);
+            Scalar m1 = m(i + 1, d);
+            CubicSplineSegmentT<Scalar> c(y0, (y1 - y0) - (2 * m0 + m1) / 6, m0 / 2, (m1 - m0) / 6);
+            c.parameterOffset = i;
+            c.outputOffset = y0;
+            c.parameterMultiplier = 1;
+            out[d][i] = c;
+        }
+    }
+}
+
+template void solveFreeSpaceCubicN<2, float>(const float *, int, const float *, const float *, CubicSplineSegment *const *);
+template void solveFreeSpaceCubicN<3, float>(const float *, int, const float *, const float *, CubicSplineSegment *const *);
+template void solveFreeSpaceCubicN<4, float>(const float *, int, const float *, const float *, CubicSplineSegment *const *);
+template void solveFreeSpaceCubicN<2, double>(const double *, int, const double *, const double *, CubicSplineSegmentd *const *);
+template void solveFreeSpaceCubicN<3, double>(const double *, int, const double *, const double *, CubicSplineSegmentd *const *);
+template void solveFreeSpaceCubicN<4, double>(const double *, int, const double *, const double *, CubicSplineSegmentd *const *);
+
+template <typename Scalar>
+void solveFreeSpaceCubic(const Point2<Scalar> *points, int count, Point2<Scalar> startSlope, Point2<Scalar> endSlope, CubicSplineSegmentT<Scalar> *xOut, CubicSplineSegmentT<Scalar> *yOut) {
+    if(count < 2) {
+        return;
+    }
+
+    const Scalar start[2] = {startSlope.x, startSlope.y};
+    const Scalar end[2] = {endSlope.x, endSlope.y};
+    CubicSplineSegmentT<Scalar> *out[2] = {xOut, yOut};
+    solveFreeSpaceCubicN<2>(&points[0].x, count, start, end, out);
+}
+
+template void solveFreeSpaceCubic<float>(const glm::vec2 *, int, glm::vec2, glm::vec2, CubicSplineSegment *, CubicSplineSegment *);
+template void solveFreeSpaceCubic<double>(const glm::dvec2 *, int, glm::dvec2, glm::dvec2, CubicSplineSegmentd *, CubicSplineSegmentd *);
+
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubic(std::vector<glm::vec2> points, glm::vec2 startSlope, glm::vec2 endSlope, StitchedSolver solver) {
+    if(points.size() < 2) {
+        return {std::vector<CubicSplineSegment>(), std::vector<CubicSplineSegment>()};
+    }
+
+    if(solver == StitchedSolver::BandedFloat) {
+        std::vector<CubicSplineSegment> xSpline(points.size() - 1);
+        std::vector<CubicSplineSegment> ySpline(points.size() - 1);
+        solveFreeSpaceCubic(points.data(), points.size(), startSlope, endSlope, xSpline.data(), ySpline.data());
+        return {xSpline, ySpline};
+    }
+    if(solver == StitchedSolver::Banded) {
+        std::vector<glm::dvec2> widePoints(points.begin(), points.end());
+        std::vector<CubicSplineSegmentd> xSpline(points.size() - 1);
+        std::vector<CubicSplineSegmentd> ySpline(points.size() - 1);
+        solveFreeSpaceCubic(widePoints.data(), widePoints.size(), glm::dvec2(startSlope), glm::dvec2(endSlope), xSpline.data(), ySpline.data());
+        return {std::vector<CubicSplineSegment>(xSpline.begin(), xSpline.end()), std::vector<CubicSplineSegment>(ySpline.begin(), ySpline.end())};
+    }
+
+    std::vector<glm::vec2> xPoints;
+    std::vector<glm::vec2> yPoints;
+    for(int i = 0; i < points.size(); i++) {
+        xPoints.push_back(glm::vec2(i, points[i].x));
+        yPoints.push_back(glm::vec2(i, points[i].y));
+    }
+
+    glm::vec2 start;
+    glm::vec2 end;
+    paramaterizeEndSlopes(points.data(), points.size(), startSlope, endSlope, start, end);
+
+    if(solver == StitchedSolver::Dense) {
+        return calculateFreeSpaceCubicDense(xPoints, yPoints, start, end);
+    }
+    return threadSparseSolver().solveFreeSpace(xPoints, yPoints, start, end);
+}
+
+//Closed loop version of the banded stitched solver, the last point joins back up with the first
+//Every point (including the first and last) gets the interior C1/C2 equation and the indices wrap around,
+//which makes the system cyclic tridiagonal instead of tridiagonal
+std::vector<CubicSplineSegment> calculateCubicPeriodic(const std::vector<glm::vec2> &points, float period) {
+    int n = points.size();
+    std::vector<CubicSplineSegment> allSegments;
+    if(n < 2) {
+        return allSegments;
+    }
+
+    //Segment i runs from point i to point i + 1, the last one closes the loop one period after the first point
+    VectorXd h(n);
+    VectorXd secant(n);
+    for(int i = 0; i < n; i++) {
+        double nextX = i + 1 < n ? points[i + 1].x : (double)points[0].x + period;
+        h(i) = nextX - points[i].x;
+        secant(i) = ((double)points[(i + 1) % n].y - points[i].y) / h(i);
+    }
+
+    VectorXd lower(n);
+    VectorXd diag(n);
+    VectorXd upper(n);
+    VectorXd m(n);
+    for(int i = 0; i < n; i++) {
+        int previous = (i + n - 1) % n;
+        lower(i) = h(previous);
+        diag(i) = 2 * (h(previous) + h(i));
+        upper(i) = h(i);
+        m(i) = 6 * (secant(i) - secant(previous));
+    }
+
+    solveCyclicTridiagonal(lower, diag, upper, m);
+
+    allSegments.reserve(n);
+    for(int i = 0; i < n; i++) {
+        int next = (i + 1) % n;
+        double hh = h(i) * h(i);
+        Vector4d v;
+        v(0) = points[i].y;
+        v(1) = h(i) * secant(i) - hh * (2 * m(i) + m(next)) / 6;
+        v(2) = hh * m(i) / 2;
+        v(3) = hh * (m(next) - m(i)) / 6;
+
+        CubicSplineSegment c(v);
+        c.parameterOffset = points[i].x;
+        c.outputOffset = points[i].y;
+        c.parameterMultiplier = h(i);
+        allSegments.push_back(c);
+    }
+
+    return allSegments;
+}
+
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceCubicPeriodic(const std::vector<glm::vec2> &points) {
+    std::vector<glm::vec2> xPoints;
+    std::vector<glm::vec2> yPoints;
+    for(int i = 0; i < points.size(); i++) {
+        xPoints.push_back(glm::vec2(i, points[i].x));
+        yPoints.push_back(glm::vec2(i, points[i].y));
+    }
+
+    std::vector<CubicSplineSegment> xSpline = calculateCubicPeriodic(xPoints, points.size());
+    std::vector<CubicSplineSegment> ySpline = calculateCubicPeriodic(yPoints, points.size());
+    return {xSpline, ySpline};
+}
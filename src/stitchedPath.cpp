@@ -0,0 +1,193 @@
+#include "stitchedPath.h"
+#include "bandedSolvers.h"
+#include "tessellate.h"
+#include <algorithm>
+
+using namespace Eigen;
+
+//Solves rows first to last of the second derivative system (see calculateCubicStitched) with every segment 1 wide:
+//M(k-1) + 4M(k) + M(k+1) = 6(s(k) - s(k-1)), and 2M + (neighbour) at the two ends of the path
+//Anything outside the rows is treated as 0
+static void solveUniformRows(int first, int last, int n, VectorXd &rhs) {
+    int size = last - first + 1;
+    VectorXd lower = VectorXd::Ones(size);
+    VectorXd diag = VectorXd::Constant(size, 4);
+    VectorXd upper = VectorXd::Ones(size);
+    if(first == 0) {
+        diag(0) = 2;
+    }
+    if(last == n) {
+        diag(size - 1) = 2;
+    }
+    solveTridiagonal(lower, diag, upper, rhs);
+}
+
+void StitchedPath::solve(const std::vector<glm::vec2> &points, glm::vec2 startSlope, glm::vec2 endSlope) {
+    waypoints = points;
+    start = startSlope;
+    end = endSlope;
+    accumulatedError = 0;
+    xSpline.clear();
+    ySpline.clear();
+    splinePoints.clear();
+    if(waypoints.size() < 2) {
+        return;
+    }
+
+    int n = waypoints.size() - 1;
+    xCurvature.resize(n + 1);
+    yCurvature.resize(n + 1);
+    for(int k = 0; k <= n; k++) {
+        glm::vec2 next = k < n ? waypoints[k + 1] - waypoints[k] : end;
+        glm::vec2 previous = k > 0 ? waypoints[k] - waypoints[k - 1] : start;
+        xCurvature(k) = 6 * ((double)next.x - previous.x);
+        yCurvature(k) = 6 * ((double)next.y - previous.y);
+    }
+    solveUniformRows(0, n, n, xCurvature);
+    solveUniformRows(0, n, n, yCurvature);
+
+    xSpline.resize(n);
+    ySpline.resize(n);
+    samplesPerSegment = TESSELLATION_STEPS;
+    splinePoints.resize(tessellatedVertexCount(n, samplesPerSegment) * 3);
+    for(int i = 0; i < n; i++) {
+        solveSegment(i);
+    }
+    tessellatePath(xSpline.data(), ySpline.data(), n, samplesPerSegment, splinePoints.data());
+}
+
+void StitchedPath::solveSegment(int i) {
+    Vector4d x;
+    x(0) = waypoints[i].x;
+    x(1) = ((double)waypoints[i + 1].x - waypoints[i].x) - (2 * xCurvature(i) + xCurvature(i + 1)) / 6;
+    x(2) = xCurvature(i) / 2;
+    x(3) = (xCurvature(i + 1) - xCurvature(i)) / 6;
+
+    Vector4d y;
+    y(0) = waypoints[i].y;
+    y(1) = ((double)waypoints[i + 1].y - waypoints[i].y) - (2 * yCurvature(i) + yCurvature(i + 1)) / 6;
+    y(2) = yCurvature(i) / 2;
+    y(3) = (yCurvature(i + 1) - yCurvature(i)) / 6;
+
+    xSpline[i] = CubicSplineSegment(x);
+    xSpline[i].parameterOffset = i;
+    xSpline[i].outputOffset = waypoints[i].x;
+    xSpline[i].parameterMultiplier = 1;
+
+    ySpline[i] = CubicSplineSegment(y);
+    ySpline[i].parameterOffset = i;
+    ySpline[i].outputOffset = waypoints[i].y;
+    ySpline[i].parameterMultiplier = 1;
+}
+
+//Re-solves and resamples segments first to last in place, plus the end vertex if last is the last segment
+VertexRange StitchedPath::resample(int first, int last) {
+    for(int i = first; i <= last; i++) {
+        solveSegment(i);
+        tessellateSegment(xSpline[i], ySpline[i], samplesPerSegment, splinePoints.data() + i * samplesPerSegment * 3);
+    }
+
+    VertexRange range;
+    range.first = first * samplesPerSegment;
+    range.count = (last - first + 1) * samplesPerSegment;
+    if(last == (int)xSpline.size() - 1) {
+        segmentEndVertex(xSpline.back(), ySpline.back(), splinePoints.data() + splinePoints.size() - 3);
+        range.count++;
+    }
+    return range;
+}
+
+//Applies a change to rows first to last of the right hand side
+//The change in M is solved over a window around those rows with M held fixed outside it. That leaves a residual
+//in the rows just outside the window equal to the change in M at its edges, and since every row is diagonally
+//dominant by at least 1, M is off by at most that residual. Positions are off by at most 1/8 of the error in M
+//(max of t(1 - t)/2 over a segment). The window doubles until the bound fits in what's left of the tolerance
+VertexRange StitchedPath::correct(int first, int last, const VectorXd &xChange, const VectorXd &yChange, float tolerance) {
+    int n = xCurvature.size() - 1;
+    for(int halfWidth = 8; ; halfWidth *= 2) {
+        int lo = std::max(0, first - halfWidth);
+        int hi = std::min(n, last + halfWidth);
+
+        //The window reached both ends, a full solve costs the same and clears the old error
+        if(lo == 0 && hi == n) {
+            solve(waypoints, start, end);
+            return VertexRange{0, vertexCount()};
+        }
+
+        VectorXd xDelta = VectorXd::Zero(hi - lo + 1);
+        VectorXd yDelta = VectorXd::Zero(hi - lo + 1);
+        xDelta.segment(first - lo, last - first + 1) = xChange;
+        yDelta.segment(first - lo, last - first + 1) = yChange;
+        solveUniformRows(lo, hi, n, xDelta);
+        solveUniformRows(lo, hi, n, yDelta);
+
+        double residual = 0;
+        if(lo > 0) {
+            residual = std::max({residual, std::abs(xDelta(0)), std::abs(yDelta(0))});
+        }
+        if(hi < n) {
+            residual = std::max({residual, std::abs(xDelta(hi - lo)), std::abs(yDelta(hi - lo))});
+        }
+        double bound = residual / 8;
+
+        if(accumulatedError + bound <= tolerance) {
+            xCurvature.segment(lo, hi - lo + 1) += xDelta;
+            yCurvature.segment(lo, hi - lo + 1) += yDelta;
+            accumulatedError += bound;
+            //Segments on either side of a changed M need new coefficients
+            return resample(std::max(0, lo - 1), std::min(n - 1, hi));
+        }
+    }
+}
+
+VertexRange StitchedPath::setPoint(size_t i, glm::vec2 point, float tolerance) {
+    if(xSpline.empty()) {
+        waypoints[i] = point;
+        return VertexRange();
+    }
+
+    //Moving point i by d changes s(i - 1) by d and s(i) by -d, which touches rows i - 1 to i + 1
+    int n = xSpline.size();
+    int k = i;
+    glm::vec2 d = point - waypoints[i];
+    waypoints[i] = point;
+
+    int first = std::max(0, k - 1);
+    int last = std::min(n, k + 1);
+    VectorXd xChange = VectorXd::Zero(last - first + 1);
+    VectorXd yChange = VectorXd::Zero(last - first + 1);
+    if(k > 0) {
+        xChange(k - 1 - first) += 6 * d.x;
+        yChange(k - 1 - first) += 6 * d.y;
+        xChange(k - first) -= 6 * d.x;
+        yChange(k - first) -= 6 * d.y;
+    }
+    if(k < n) {
+        xChange(k - first) -= 6 * d.x;
+        yChange(k - first) -= 6 * d.y;
+        xChange(k + 1 - first) += 6 * d.x;
+        yChange(k + 1 - first) += 6 * d.y;
+    }
+
+    //Segments next to the point change even if M didn't, correct always covers them since the window contains rows k - 1 to k + 1
+    return correct(first, last, xChange, yChange, tolerance);
+}
+
+VertexRange StitchedPath::setStartSlope(glm::vec2 slope, float tolerance) {
+    glm::vec2 d = slope - start;
+    start = slope;
+    if(xSpline.empty()) {
+        return VertexRange();
+    }
+    return correct(0, 0, VectorXd::Constant(1, -6 * d.x), VectorXd::Constant(1, -6 * d.y), tolerance);
+}
+
+VertexRange StitchedPath::setEndSlope(glm::vec2 slope, float tolerance) {
+    glm::vec2 d = slope - end;
+    end = slope;
+    if(xSpline.empty()) {
+        return VertexRange();
+    }
+    int n = xSpline.size();
+    return correct(n, n, VectorXd::Constant(1, 6 * d.x), VectorXd::Constant(1, 6 * d.y), tolerance);
+}
@@ -0,0 +1,186 @@
+#include "streamBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+//Smallest region, so the first few edits of a path don't each double the buffer
+static const int minimumVertices = 1024;
+
+static PFNGLBUFFERSTORAGEPROC bufferStorage = nullptr;
+
+void StreamBuffer::loadBufferStorage(GLADloadproc load) {
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    bool supported = major > 4 || (major == 4 && minor >= 4);
+    GLint extensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions);
+    for(GLint i = 0; i < extensions && !supported; i++) {
+        supported = std::strcmp((const char *)glGetStringi(GL_EXTENSIONS, i), "GL_ARB_buffer_storage") == 0;
+    }
+    bufferStorage = supported ? (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage") : nullptr;
+}
+
+void StreamBuffer::create(GLuint vao, int floatsPerVertex) {
+    this->vao = vao;
+    this->floatsPerVertex = floatsPerVertex;
+    persistentMapping = bufferStorage != nullptr;
+    reserve(minimumVertices);
+}
+
+void StreamBuffer::destroy() {
+    for(GLsync &fence : fences) {
+        if(fence) {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    if(storage) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        storage = nullptr;
+    }
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    regionVertices = 0;
+    current = count = 0;
+    pendingRegion = -1;
+    mapped = false;
+}
+
+void StreamBuffer::reserve(int vertices) {
+    if(vertices <= regionVertices) {
+        return;
+    }
+    //Immutable storage can't be resized, so growing always starts a new buffer. Deleting the old one is safe while
+    //draws from it are still in flight, GL keeps it alive until they finish, so its fences can just be dropped
+    int grown = std::max(vertices, std::max(regionVertices * 2, minimumVertices));
+    destroy();
+    regionVertices = grown;
+    GLsizeiptr bytes = (GLsizeiptr)regions * regionVertices * floatsPerVertex * sizeof(float);
+
+    glGenBuffers(1, &buffer);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if(persistentMapping) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        storage = (float *)glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags);
+    }
+    else {
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    }
+    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, floatsPerVertex * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+}
+
+void StreamBuffer::waitForRegion(int region) {
+    GLsync &fence = fences[region];
+    if(!fence) {
+        return;
+    }
+    //Only the first wait needs to flush, after that the fence is on its way to the GPU
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while(glClientWaitSync(fence, flags, 1000000000) == GL_TIMEOUT_EXPIRED) {
+        flags = 0;
+    }
+    glDeleteSync(fence);
+    fence = 0;
+}
+
+void StreamBuffer::fenceRegion(int region) {
+    //A newer fence covers everything the old one did
+    GLsync &fence = fences[region];
+    if(fence) {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+float *StreamBuffer::mapRegion(int region, int first, int rangeCount, int vertices) {
+    pendingRegion = region;
+    pendingCount = vertices;
+    mapped = false;
+
+    size_t offset = ((size_t)region * regionVertices + first) * floatsPerVertex;
+    if(persistentMapping) {
+        return storage + offset;
+    }
+    if(rangeCount == 0) {
+        return nullptr;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    mapped = true;
+    return (float *)glMapBufferRange(GL_ARRAY_BUFFER, offset * sizeof(float), (GLsizeiptr)rangeCount * floatsPerVertex * sizeof(float), flags);
+}
+
+float *StreamBuffer::map(int vertices) {
+    reserve(vertices);
+    //Never the committed region, which is what the next frames draw until this write is committed
+    int region = (current + 1) % regions;
+    waitForRegion(region);
+    return mapRegion(region, 0, vertices, vertices);
+}
+
+float *StreamBuffer::mapRange(int first, int rangeCount) {
+    first = std::min(std::max(first, 0), count);
+    rangeCount = std::min(std::max(rangeCount, 0), count - first);
+    int source = current;
+    int region = (current + 1) % regions;
+    waitForRegion(region);
+
+    //Everything around the range is carried over on the GPU, which never touches the range itself, so the copies
+    //and the caller's writes can't race. Both regions are fenced after the copies, so neither is written again
+    //(by a later map) until the copies have read and written them
+    GLsizeiptr stride = floatsPerVertex * sizeof(float);
+    GLintptr from = (GLintptr)source * regionVertices * stride;
+    GLintptr to = (GLintptr)region * regionVertices * stride;
+    int end = first + rangeCount;
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if(first > 0) {
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, from, to, first * stride);
+    }
+    if(end < count) {
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, from + end * stride, to + end * stride, (count - end) * stride);
+    }
+    fenceRegion(source);
+    fenceRegion(region);
+    return mapRegion(region, first, rangeCount, count);
+}
+
+void StreamBuffer::commit() {
+    if(pendingRegion < 0) {
+        return;
+    }
+    //Coherent mappings are seen by every command issued after the write, nothing to flush
+    if(mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        //The contents are undefined if the mapping was lost (e.g. a mode switch), so draw nothing rather than garbage
+        if(!glUnmapBuffer(GL_ARRAY_BUFFER)) {
+            pendingCount = 0;
+        }
+        mapped = false;
+    }
+    current = pendingRegion;
+    count = pendingCount;
+    pendingRegion = -1;
+}
+
+void StreamBuffer::upload(const float *vertices, int vertexCount) {
+    float *out = map(vertexCount);
+    if(vertexCount > 0) {
+        std::memcpy(out, vertices, (size_t)vertexCount * floatsPerVertex * sizeof(float));
+    }
+    commit();
+}
+
+void StreamBuffer::draw(GLenum mode) {
+    if(count == 0) {
+        return;
+    }
+    glBindVertexArray(vao);
+    glDrawArrays(mode, first(), count);
+    fenceRegion(current);
+}
@@ -0,0 +1,105 @@
+#include "tangentStream.h"
+#include <algorithm>
+
+TangentStream::TangentStream(TangentMode mode, float tension) : mode(mode), tension(tension) {}
+
+void TangentStream::reset() {
+    count = 0;
+    spacing = 1;
+}
+
+//Uniform modes use 1 per waypoint, centripetal uses sqrt(|chord|)
+//Repeated waypoints would give 0, which is clamped so the tangent stays finite
+float TangentStream::knotSpacing(glm::vec2 from, glm::vec2 to) const {
+    if(mode != TangentMode::Centripetal) {
+        return 1;
+    }
+    return std::max(std::sqrt(glm::length(to - from)), 1e-6f);
+}
+
+glm::vec2 TangentStream::scaled(glm::vec2 tangent) const {
+    return mode == TangentMode::Cardinal ? tangent * (1 - tension) : tangent;
+}
+
+//Tangents are kept per unit of knot spacing. Each segment is still 1 wide in the waypoint index paramaterization,
+//so both end tangents get scaled by that segment's spacing. With uniform spacing this is just the plain Hermite segment
+void TangentStream::emit(size_t segment, glm::vec2 endTangent, CubicSplineSegment &xOut, CubicSplineSegment &yOut) {
+    glm::vec2 startSlope = previousTangent * spacing;
+    glm::vec2 endSlope = endTangent * spacing;
+    float i = segment;
+
+    xOut = hermiteSegment(previous.x, current.x, startSlope.x, endSlope.x);
+    xOut.parameterOffset = i;
+    xOut.outputOffset = previous.x;
+    xOut.parameterMultiplier = 1;
+
+    yOut = hermiteSegment(previous.y, current.y, startSlope.y, endSlope.y);
+    yOut.parameterOffset = i;
+    yOut.outputOffset = previous.y;
+    yOut.parameterMultiplier = 1;
+}
+
+bool TangentStream::push(glm::vec2 point, CubicSplineSegment &xOut, CubicSplineSegment &yOut) {
+    count++;
+    if(count == 1) {
+        current = point;
+        return false;
+    }
+
+    float nextSpacing = knotSpacing(current, point);
+    if(count == 2) {
+        //One sided tangent at the first waypoint
+        previousTangent = scaled((point - current) / nextSpacing);
+        previous = current;
+        current = point;
+        spacing = nextSpacing;
+        return false;
+    }
+
+    //Derivative at current of the quadratic through previous, current and point over their knots
+    //(reduces to (point - previous) / 2 with uniform spacing)
+    glm::vec2 tangent = scaled((current - previous) / spacing - (point - previous) / (spacing + nextSpacing) + (point - current) / nextSpacing);
+
+    //Lookahead is in, so the segment ending at current (waypoint count - 2) is final
+    emit(count - 3, tangent, xOut, yOut);
+
+    previous = current;
+    current = point;
+    previousTangent = tangent;
+    spacing = nextSpacing;
+    return true;
+}
+
+bool TangentStream::finish(CubicSplineSegment &xOut, CubicSplineSegment &yOut) {
+    if(count < 2) {
+        return false;
+    }
+
+    //One sided tangent at the last waypoint
+    emit(count - 2, scaled((current - previous) / spacing), xOut, yOut);
+    reset();
+    return true;
+}
+
+std::vector<std::vector<CubicSplineSegment>> calculateFreeSpaceTangentSpline(const std::vector<glm::vec2> &points, TangentMode mode, float tension) {
+    std::vector<CubicSplineSegment> xSpline;
+    std::vector<CubicSplineSegment> ySpline;
+    xSpline.reserve(points.size());
+    ySpline.reserve(points.size());
+
+    TangentStream stream(mode, tension);
+    CubicSplineSegment x;
+    CubicSplineSegment y;
+    for(glm::vec2 p : points) {
+        if(stream.push(p, x, y)) {
+            xSpline.push_back(x);
+            ySpline.push_back(y);
+        }
+    }
+    if(stream.finish(x, y)) {
+        xSpline.push_back(x);
+        ySpline.push_back(y);
+    }
+
+    return {xSpline, ySpline};
+}
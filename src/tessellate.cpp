@@ -0,0 +1,103 @@
+#include "tessellate.h"
+#include <algorithm>
+
+//Differences of a + bt + ct^2 + dt^3 with step h, kept in double so the running sums don't drift over a segment
+struct Differences {
+    double value, first, second, third;
+
+    Differences(const CubicSplineSegment &s, double h) {
+        double h2 = h * h;
+        double h3 = h2 * h;
+        value = s.a;
+        first = s.b * h + s.c * h2 + s.d * h3;
+        second = 2 * s.c * h2 + 6 * s.d * h3;
+        third = 6 * s.d * h3;
+    }
+
+    void step() {
+        value += first;
+        first += second;
+        second += third;
+    }
+};
+
+void tessellateSegment(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment, int steps, float *out) {
+    double h = 1.0 / steps;
+    Differences x(xSegment, h);
+    Differences y(ySegment, h);
+    for(int i = 0; i < steps; i++) {
+        out[3 * i] = x.value;
+        out[3 * i + 1] = y.value;
+        out[3 * i + 2] = 0.0f;
+        x.step();
+        y.step();
+    }
+}
+
+void segmentEndVertex(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment, float *out) {
+    out[0] = (double)xSegment.a + xSegment.b + xSegment.c + xSegment.d;
+    out[1] = (double)ySegment.a + ySegment.b + ySegment.c + ySegment.d;
+    out[2] = 0.0f;
+}
+
+int tessellatePath(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segmentCount, int steps, float *out) {
+    if(segmentCount < 1) {
+        return 0;
+    }
+    for(int k = 0; k < segmentCount; k++) {
+        tessellateSegment(xSegments[k], ySegments[k], steps, out + (size_t)k * steps * 3);
+    }
+    segmentEndVertex(xSegments[segmentCount - 1], ySegments[segmentCount - 1], out + (size_t)segmentCount * steps * 3);
+    return tessellatedVertexCount(segmentCount, steps);
+}
+
+float maxSecondDerivative(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment) {
+    //p''(t) = 2c + 6dt
+    double startX = 2.0 * xSegment.c;
+    double startY = 2.0 * ySegment.c;
+    double endX = startX + 6.0 * xSegment.d;
+    double endY = startY + 6.0 * ySegment.d;
+    return std::sqrt(std::max(startX * startX + startY * startY, endX * endX + endY * endY));
+}
+
+//(1/steps)^2/8 * secondDerivative <= tolerance
+int flatnessSteps(float secondDerivative, float tolerance, int maxSteps) {
+    //Straight segments are exact with one chord, otherwise no tolerance (or a NaN one) can only be met by the cap
+    if(!(secondDerivative > 0)) {
+        return 1;
+    }
+    if(!(tolerance > 0)) {
+        return std::max(1, maxSteps);
+    }
+    double steps = std::ceil(std::sqrt(secondDerivative / (8.0 * tolerance)));
+    return std::max(1, (int)std::min(steps, (double)maxSteps));
+}
+
+int flatnessSteps(const CubicSplineSegment &xSegment, const CubicSplineSegment &ySegment, float tolerance, int maxSteps) {
+    return flatnessSteps(maxSecondDerivative(xSegment, ySegment), tolerance, maxSteps);
+}
+
+int adaptiveVertexCount(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segmentCount, float tolerance, int *steps) {
+    if(segmentCount < 1) {
+        return 0;
+    }
+    int vertices = 1;
+    for(int k = 0; k < segmentCount; k++) {
+        steps[k] = flatnessSteps(xSegments[k], ySegments[k], tolerance);
+        vertices += steps[k];
+    }
+    return vertices;
+}
+
+int tessellatePathAdaptive(const CubicSplineSegment *xSegments, const CubicSplineSegment *ySegments, int segmentCount, const int *steps, float *out) {
+    if(segmentCount < 1) {
+        return 0;
+    }
+    int vertices = 0;
+    for(int k = 0; k < segmentCount; k++) {
+        tessellateSegment(xSegments[k], ySegments[k], steps[k], out + (size_t)vertices * 3);
+        vertices += steps[k];
+    }
+    segmentEndVertex(xSegments[segmentCount - 1], ySegments[segmentCount - 1], out + (size_t)vertices * 3);
+    return vertices + 1;
+}
@@ -0,0 +1,109 @@
+#include "threadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int threads) {
+    workerCount = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    ranges.reset(new WorkRange[workerCount]);
+
+    //Worker 0 is whichever thread calls parallelFor
+    for(unsigned int i = 1; i < workerCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(jobLock);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &job) {
+    if(count == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(jobLock);
+        for(unsigned int i = 0; i < workerCount; i++) {
+            std::lock_guard<std::mutex> rangeGuard(ranges[i].lock);
+            ranges[i].begin = count * i / workerCount;
+            ranges[i].end = count * (i + 1) / workerCount;
+        }
+        task = &job;
+        busyWorkers = workerCount - 1;
+        generation++;
+    }
+    jobReady.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(jobLock);
+    jobDone.wait(lock, [this] { return busyWorkers == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::workerLoop(unsigned int id) {
+    size_t seen = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(jobLock);
+            jobReady.wait(lock, [&] { return stopping || generation != seen; });
+            if(stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        runTasks(id);
+
+        std::lock_guard<std::mutex> guard(jobLock);
+        if(--busyWorkers == 0) {
+            jobDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks(unsigned int id) {
+    size_t index;
+    while(takeTask(id, index)) {
+        (*task)(index);
+    }
+}
+
+bool ThreadPool::takeTask(unsigned int id, size_t &index) {
+    {
+        std::lock_guard<std::mutex> guard(ranges[id].lock);
+        if(ranges[id].begin < ranges[id].end) {
+            index = ranges[id].begin++;
+            return true;
+        }
+    }
+
+    //Out of work, steal the back half of the first worker that still has some
+    for(unsigned int i = 1; i < workerCount; i++) {
+        WorkRange &victim = ranges[(id + i) % workerCount];
+        size_t stolenBegin;
+        size_t stolenEnd;
+        {
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if(victim.begin >= victim.end) {
+                continue;
+            }
+            stolenBegin = victim.begin + (victim.end - victim.begin) / 2;
+            stolenEnd = victim.end;
+            victim.end = stolenBegin;
+        }
+
+        std::lock_guard<std::mutex> guard(ranges[id].lock);
+        index = stolenBegin;
+        ranges[id].begin = stolenBegin + 1;
+        ranges[id].end = stolenEnd;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,110 @@
+#include "velocityProfile.h"
+#include <algorithm>
+#include <limits>
+
+//|x'y'' - y'x''| / |p'|^3, infinite where the path stops and turns (a cusp) so the speed there drops to 0
+static double curvature(const CubicSplineSegment &x, const CubicSplineSegment &y, double t) {
+    double dx = x.b + t * (2 * x.c + 3 * t * x.d);
+    double dy = y.b + t * (2 * y.c + 3 * t * y.d);
+    double ddx = 2 * x.c + 6 * t * x.d;
+    double ddy = 2 * y.c + 6 * t * y.d;
+    double cross = std::abs(dx * ddy - dy * ddx);
+    double speed = std::sqrt(dx * dx + dy * dy);
+    if(cross == 0) {
+        return 0;
+    }
+    if(speed == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return cross / (speed * speed * speed);
+}
+
+//One pass of v(next)^2 <= v(previous)^2 + 2 a ds from first towards last (either direction)
+//The jerk limit lets the acceleration grow by jerk * dt per step, where dt is how long the previous step took,
+//or the time to cover ds from rest under constant jerk (ds = jerk dt^3 / 6) if that is shorter
+static void limitAcceleration(std::vector<double> &velocity, int first, int last, double ds, double maxAcceleration, double maxJerk) {
+    int direction = last > first ? 1 : -1;
+    double acceleration = 0;
+    double restTime = maxJerk > 0 ? std::cbrt(6 * ds / maxJerk) : 0;
+    for(int i = first; i != last; i += direction) {
+        double v = velocity[i];
+        double usable = maxAcceleration;
+        if(maxJerk > 0) {
+            double dt = v > 0 ? std::min(ds / v, restTime) : restTime;
+            usable = std::min(usable, std::max(acceleration, 0.0) + maxJerk * dt);
+        }
+        double &next = velocity[i + direction];
+        next = std::min(next, std::sqrt(v * v + 2 * usable * ds));
+        acceleration = (next * next - v * v) / (2 * ds);
+    }
+}
+
+std::vector<ProfileSample> calculateVelocityProfile(const ArcLengthTable &path, const VelocityLimits &limits, float spacing) {
+    double length = path.totalLength();
+    if(length <= 0 || spacing <= 0) {
+        return std::vector<ProfileSample>(1);
+    }
+    int steps = std::max((int)std::ceil(length / spacing), 1);
+    double ds = length / steps;
+    std::vector<ProfileSample> profile(steps + 1);
+
+    //Speed caps from the velocity limit and v^2 * curvature <= maxLateralAcceleration
+    std::vector<double> velocity(steps + 1);
+    const CubicSplineSegment *x = path.xSegments();
+    const CubicSplineSegment *y = path.ySegments();
+    for(int i = 0; i <= steps; i++) {
+        profile[i].distance = i * ds;
+        PathLocation location = path.locate(profile[i].distance);
+        double k = curvature(x[location.segment], y[location.segment], location.t);
+        double cap = limits.maxVelocity;
+        if(k > 0) {
+            cap = std::min(cap, std::sqrt(limits.maxLateralAcceleration / k));
+        }
+        velocity[i] = cap;
+    }
+    velocity[0] = std::min(velocity[0], (double)limits.startVelocity);
+    velocity[steps] = std::min(velocity[steps], (double)limits.endVelocity);
+
+    //Braking first, then accelerating. Every forward step ends at least as fast as it started,
+    //so the forward pass never undoes what the backward pass guaranteed
+    limitAcceleration(velocity, steps, 0, ds, limits.maxDeceleration, limits.maxJerk);
+    limitAcceleration(velocity, 0, steps, ds, limits.maxAcceleration, limits.maxJerk);
+
+    //Constant acceleration inside every step, dt = ds / average speed
+    double time = 0;
+    for(int i = 0; i <= steps; i++) {
+        profile[i].velocity = velocity[i];
+        profile[i].time = time;
+        if(i < steps) {
+            profile[i].acceleration = (velocity[i + 1] * velocity[i + 1] - velocity[i] * velocity[i]) / (2 * ds);
+            double average = (velocity[i] + velocity[i + 1]) / 2;
+            time += average > 0 ? ds / average : 0;
+        }
+        else {
+            profile[i].acceleration = profile[i - 1].acceleration;
+        }
+    }
+    return profile;
+}
+
+ProfileSample sampleProfile(const std::vector<ProfileSample> &profile, float time) noexcept {
+    if(profile.empty()) {
+        return ProfileSample();
+    }
+    if(time <= profile.front().time) {
+        return profile.front();
+    }
+    if(time >= profile.back().time) {
+        return profile.back();
+    }
+
+    auto after = std::upper_bound(profile.begin(), profile.end(), time, [](float t, const ProfileSample &s) { return t < s.time; });
+    const ProfileSample &start = *(after - 1);
+    float dt = time - start.time;
+    ProfileSample sample;
+    sample.time = time;
+    sample.acceleration = start.acceleration;
+    sample.velocity = start.velocity + start.acceleration * dt;
+    sample.distance = std::min(start.distance + (start.velocity + start.acceleration * dt / 2) * dt, after->distance);
+    return sample;
+}